@@ -0,0 +1,89 @@
+#include "autoplayer.h"
+#include "game.h"
+#include <algorithm>
+#include <cmath>
+
+// Position along one axis after bouncing between low and high: unfold the
+// reflections into a straight line, then fold it back with period 2 * span
+static float reflect(float position, float velocity, float seconds, float low, float high) {
+    float span = high - low;
+    if (span <= 0.0f) return low;
+
+    float period = 2.0f * span;
+    float unfolded = fmodf(position - low + velocity * seconds, period);
+    if (unfolded < 0.0f) unfolded += period;
+    return low + (unfolded <= span ? unfolded : period - unfolded);
+}
+
+Autoplayer::Autoplayer(const AutoplayerConfig& config)
+    : config(config), aiming(false), tapTime(0.0f), tapX(0.0f), tapY(0.0f),
+      lastTapX(-1.0f), lastTapY(-1.0f), aimError(0.0f, 1.0f) {
+    setConfig(config);
+}
+
+void Autoplayer::setConfig(const AutoplayerConfig& newConfig) {
+    config = newConfig;
+    // Negative or NaN (from a property or the command line) aims exactly
+    config.aimErrorPx = std::max(0.0f, config.aimErrorPx);
+    aiming = false;
+}
+
+void Autoplayer::reset(uint32_t seed) {
+    rng.seed(seed ^ 0x27d4eb2fu);
+    aimError.reset();
+    aiming = false;
+    lastTapX = -1.0f;
+    lastTapY = -1.0f;
+}
+
+void Autoplayer::predict(const Circle& circle, float seconds, int screenWidth, int screenHeight,
+                         float& x, float& y) {
+    x = reflect(circle.x, circle.velocityX, seconds, circle.radius, screenWidth - circle.radius);
+    y = reflect(circle.y, circle.velocityY, seconds, circle.radius, screenHeight - circle.radius);
+}
+
+bool Autoplayer::update(const Game& game, float time, float& x, float& y) {
+    if (aiming) {
+        if (time < tapTime) return false;
+
+        aiming = false;
+        x = tapX;
+        y = tapY;
+        lastTapX = tapX;
+        lastTapY = tapY;
+        return true;
+    }
+
+    const std::vector<Circle>& circles = game.getCircles();
+    if (circles.empty() || game.isGameOver()) return false;
+
+    if (lastTapX < 0.0f) {
+        lastTapX = game.getScreenWidth() * 0.5f;
+        lastTapY = game.getScreenHeight() * 0.5f;
+    }
+
+    // Look once, then commit: the tap lands where the target will be after
+    // the reaction time, whatever happens on screen meanwhile
+    float bestDistance = INFINITY;
+    for (const auto& circle : circles) {
+        float predictedX, predictedY;
+        predict(circle, config.reactionTime, game.getScreenWidth(), game.getScreenHeight(),
+                predictedX, predictedY);
+        float dx = predictedX - lastTapX;
+        float dy = predictedY - lastTapY;
+        float distance = dx * dx + dy * dy;
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            tapX = predictedX;
+            tapY = predictedY;
+        }
+    }
+
+    if (config.aimErrorPx > 0.0f) {
+        tapX += aimError(rng) * config.aimErrorPx;
+        tapY += aimError(rng) * config.aimErrorPx;
+    }
+    tapTime = time + config.reactionTime;
+    aiming = true;
+    return false;
+}
@@ -0,0 +1,52 @@
+#ifndef TOUCHGAME_AUTOPLAYER_H
+#define TOUCHGAME_AUTOPLAYER_H
+
+#include <cstdint>
+#include <random>
+
+class Game;
+struct Circle;
+
+struct AutoplayerConfig {
+    float reactionTime = 0.25f;  // seconds from looking at the screen to the tap landing
+    float aimErrorPx = 12.0f;    // std-dev of the tap around the predicted point; 0 aims exactly
+};
+
+// Plays the game like a quick, slightly sloppy human, as a repeatable load
+// generator for soak tests and frame-time benchmarks at any round.
+//
+// Each decision looks at the circles once, predicts where every one will
+// be when the tap lands one reaction time later (bouncing off the screen
+// edges exactly as Game::update does) and goes for the one closest to the
+// previous tap, with Gaussian aim error. The caller delivers the tap
+// through its normal touch path; the bot never touches Game state itself.
+class Autoplayer {
+public:
+    explicit Autoplayer(const AutoplayerConfig& config = AutoplayerConfig());
+
+    void setConfig(const AutoplayerConfig& newConfig);
+    const AutoplayerConfig& getConfig() const { return config; }
+
+    // Forgets the pending tap; seed makes the aim error repeatable
+    void reset(uint32_t seed);
+    // Once per tick with a clock in seconds. Returns true and fills x/y
+    // (pixels) when a tap lands this tick.
+    bool update(const Game& game, float time, float& x, float& y);
+
+    // Where the circle will be after `seconds` of Game::update
+    static void predict(const Circle& circle, float seconds, int screenWidth, int screenHeight,
+                        float& x, float& y);
+
+private:
+    AutoplayerConfig config;
+    bool aiming;
+    float tapTime;
+    float tapX;
+    float tapY;
+    float lastTapX;         // hand position; the screen centre at first
+    float lastTapY;
+    std::mt19937 rng;
+    std::normal_distribution<float> aimError; // unit; scaled by config.aimErrorPx
+};
+
+#endif // TOUCHGAME_AUTOPLAYER_H
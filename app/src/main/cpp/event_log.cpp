@@ -0,0 +1,384 @@
+#include "event_log.h"
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+#define LOG_TAG "TouchGame"
+
+namespace eventlog {
+
+namespace {
+
+struct EventDescriptor {
+    const char* name;
+    const char* format;
+};
+
+// Indexed by EventId
+const EventDescriptor kDescriptors[] = {
+    {"GameInit", "Game initialized: %dx%d, baseRadius: %.1f"},
+    {"CircleReset", "Circle reset: %d circles, radius=%.1f, speed=%.1f, round=%d"},
+    {"CircleHit", "Hit circle! Score: %d (+%d), Remaining: %d"},
+    {"TouchMiss", "Touch missed at %.1f, %.1f"},
+    {"LevelComplete", "Level complete! Advancing to round %d"},
+    {"GameReset", "Game reset"},
+    {"LevelsLoaded", "Level table mapped: %d rounds, %d effects"},
+    {"LevelsMissing", "levels.bin missing or invalid, using the built-in curve"},
+    {"BallStyleSet", "Ball style %d (0 mesh, 1 impostor), supported %d"},
+    {"AutoplaySet", "Autoplay %d from round %d: reaction %.0f ms, aim error %.1f px"},
+    {"ParticleModeSet", "Particle mode %d (0 cpu, 1 gpu, 2 packed), supported %d"},
+};
+
+static_assert(sizeof(kDescriptors) / sizeof(kDescriptors[0]) == static_cast<size_t>(EventId::Count),
+              "every EventId needs a descriptor");
+
+const char kLevelChars[] = {'V', 'D', 'I', 'W', 'E'};
+
+const uint64_t kRingCapacity = 1024; // records per thread, power of two
+const int kMaxRings = 16;
+
+// Rings are never freed, so dump() and the crash handler can read them at
+// any time. When its thread exits a ring is marked free and the next thread
+// that needs one takes it over; records from before the takeover are then
+// skipped, since they belong to the previous owner.
+struct EventRing {
+    std::atomic<uint64_t> head{0};       // total records ever written
+    std::atomic<uint64_t> ownerStart{0}; // head when the current owner took over
+    std::atomic<uint32_t> threadId{0};
+    std::atomic<bool> inUse{true};
+    EventRecord records[kRingCapacity];
+};
+
+std::atomic<EventRing*> g_rings[kMaxRings];
+std::atomic<int> g_ringCount{0};
+std::atomic<uint32_t> g_dropped{0};
+
+// Gives the ring back when the owning thread exits
+struct RingOwner {
+    EventRing* ring = nullptr;
+    ~RingOwner() {
+        if (ring) ring->inUse.store(false, std::memory_order_release);
+        ring = nullptr;
+    }
+};
+
+thread_local RingOwner t_owner;
+
+const size_t kAltStackSize = 64 * 1024;
+
+// Per-thread alternate stack for the crash handler, so a stack overflow can
+// still be reported. Threads that already have one (ART installs its own
+// on threads it attaches) keep it.
+struct AltStack {
+    void* memory = nullptr;
+
+    void install() {
+        stack_t current;
+        if (memory || sigaltstack(nullptr, &current) != 0 || !(current.ss_flags & SS_DISABLE)) return;
+
+        stack_t stack;
+        memset(&stack, 0, sizeof(stack));
+        stack.ss_size = kAltStackSize;
+        stack.ss_sp = memory = malloc(kAltStackSize);
+        if (memory && sigaltstack(&stack, nullptr) != 0) {
+            free(memory);
+            memory = nullptr;
+        }
+    }
+
+    ~AltStack() {
+        if (!memory) return;
+        stack_t disable;
+        memset(&disable, 0, sizeof(disable));
+        disable.ss_flags = SS_DISABLE;
+        sigaltstack(&disable, nullptr);
+        free(memory);
+    }
+};
+
+thread_local AltStack t_altStack;
+
+const int kCrashSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+const int kCrashSignalCount = sizeof(kCrashSignals) / sizeof(kCrashSignals[0]);
+struct sigaction g_previousActions[kCrashSignalCount];
+std::atomic<bool> g_crashHandlerInstalled{false};
+
+uint64_t nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+uint32_t currentThreadId() {
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+}
+
+// Prefers a slot no thread has used yet, so the records of exited threads
+// stay readable for as long as possible, then takes over a freed ring.
+// Null when every slot belongs to a live thread.
+EventRing* acquireRing() {
+    t_altStack.install();
+
+    int slot = g_ringCount.load(std::memory_order_relaxed);
+    while (slot < kMaxRings &&
+           !g_ringCount.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed)) {
+    }
+    if (slot < kMaxRings) {
+        EventRing* ring = new EventRing();
+        ring->threadId.store(currentThreadId(), std::memory_order_relaxed);
+        g_rings[slot].store(ring, std::memory_order_release);
+        return ring;
+    }
+
+    for (int i = 0; i < kMaxRings; i++) {
+        EventRing* ring = g_rings[i].load(std::memory_order_acquire);
+        bool inUse = false;
+        if (!ring || !ring->inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire)) {
+            continue;
+        }
+        ring->threadId.store(currentThreadId(), std::memory_order_relaxed);
+        ring->ownerStart.store(ring->head.load(std::memory_order_relaxed), std::memory_order_release);
+        return ring;
+    }
+    return nullptr;
+}
+
+int ringCount() {
+    return std::min(g_ringCount.load(std::memory_order_acquire), kMaxRings);
+}
+
+// Index of the oldest record of the current owner still in the ring
+uint64_t firstRecord(const EventRing* ring, uint64_t end) {
+    uint64_t begin = end > kRingCapacity ? end - kRingCapacity : 0;
+    return std::max(begin, ring->ownerStart.load(std::memory_order_acquire));
+}
+
+void emitLine(int level, const char* line) {
+#ifdef __ANDROID__
+    __android_log_write(level >= TG_LOG_LEVEL_ERROR ? ANDROID_LOG_ERROR : ANDROID_LOG_INFO,
+                        LOG_TAG, line);
+#else
+    (void)level;
+    ::write(STDERR_FILENO, line, strlen(line));
+    ::write(STDERR_FILENO, "\n", 1);
+#endif
+}
+
+// Expands the event's format string with its recorded arguments. Only uses
+// snprintf on stack buffers so the crash handler can share it.
+int formatRecord(const EventRecord& record, uint32_t threadId, char* out, size_t size) {
+    const EventDescriptor& desc = record.id < static_cast<uint16_t>(EventId::Count)
+                                  ? kDescriptors[record.id]
+                                  : EventDescriptor{"Unknown", ""};
+    char level = record.level < sizeof(kLevelChars) ? kLevelChars[record.level] : '?';
+
+    int written = snprintf(out, size, "%llu.%06llu %5u %c %s: ",
+                           (unsigned long long)(record.timestampNs / 1000000000ull),
+                           (unsigned long long)((record.timestampNs / 1000ull) % 1000000ull),
+                           threadId, level, desc.name);
+    if (written < 0 || static_cast<size_t>(written) >= size) return static_cast<int>(size) - 1;
+
+    int argIndex = 0;
+    for (const char* p = desc.format; *p && static_cast<size_t>(written) < size - 1; p++) {
+        if (*p != '%') {
+            out[written++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[written++] = '%';
+            p++;
+            continue;
+        }
+
+        // Copy the conversion spec, e.g. "%.1f"
+        char spec[16];
+        size_t specLen = 0;
+        spec[specLen++] = *p++;
+        while (*p && !strchr("diuxXfFeEgGc", *p) && specLen < sizeof(spec) - 2) {
+            spec[specLen++] = *p++;
+        }
+        if (!*p) break;
+        char conversion = *p;
+        spec[specLen++] = conversion;
+        spec[specLen] = '\0';
+
+        int n;
+        if (argIndex >= record.argCount) {
+            n = snprintf(out + written, size - written, "?");
+        } else {
+            const ArgValue& arg = record.args[argIndex];
+            int type = (record.argTypes >> (argIndex * 2)) & 3;
+            bool floatSpec = strchr("fFeEgG", conversion) != nullptr;
+            if (floatSpec) {
+                double value = type == ARG_FLOAT ? arg.f : type == ARG_UINT ? arg.u : arg.i;
+                n = snprintf(out + written, size - written, spec, value);
+            } else if (type == ARG_FLOAT) {
+                n = snprintf(out + written, size - written, spec, static_cast<int>(arg.f));
+            } else {
+                n = snprintf(out + written, size - written, spec, arg.i);
+            }
+        }
+        argIndex++;
+        if (n < 0) break;
+        written = std::min(written + n, static_cast<int>(size) - 1);
+    }
+    out[written] = '\0';
+    return written;
+}
+
+void crashHandler(int sig, siginfo_t*, void*) {
+    char line[256];
+    snprintf(line, sizeof(line), "Fatal signal %d, event log follows", sig);
+    emitLine(TG_LOG_LEVEL_ERROR, line);
+
+    // Merge the live rings by timestamp without allocating
+    int count = ringCount();
+    EventRing* rings[kMaxRings];
+    uint64_t cursor[kMaxRings];
+    uint64_t end[kMaxRings];
+    for (int i = 0; i < count; i++) {
+        rings[i] = g_rings[i].load(std::memory_order_acquire);
+        end[i] = rings[i] ? rings[i]->head.load(std::memory_order_acquire) : 0;
+        cursor[i] = rings[i] ? std::min(firstRecord(rings[i], end[i]), end[i]) : 0;
+    }
+
+    for (;;) {
+        int next = -1;
+        for (int i = 0; i < count; i++) {
+            if (!rings[i] || cursor[i] >= end[i]) continue;
+            const EventRecord& candidate = rings[i]->records[cursor[i] & (kRingCapacity - 1)];
+            if (next < 0 || candidate.timestampNs <
+                    rings[next]->records[cursor[next] & (kRingCapacity - 1)].timestampNs) {
+                next = i;
+            }
+        }
+        if (next < 0) break;
+
+        const EventRecord& record = rings[next]->records[cursor[next] & (kRingCapacity - 1)];
+        formatRecord(record, rings[next]->threadId.load(std::memory_order_relaxed), line, sizeof(line));
+        emitLine(record.level, line);
+        cursor[next]++;
+    }
+
+    uint32_t dropped = droppedRecords();
+    if (dropped > 0) {
+        snprintf(line, sizeof(line), "(%u records dropped: too many logging threads)", dropped);
+        emitLine(TG_LOG_LEVEL_ERROR, line);
+    }
+
+    // Hand the signal to whoever was installed before us (debuggerd on Android)
+    for (int i = 0; i < kCrashSignalCount; i++) {
+        sigaction(kCrashSignals[i], &g_previousActions[i], nullptr);
+    }
+    raise(sig);
+}
+
+} // namespace
+
+void write(int level, EventId id, uint8_t argCount, uint8_t argTypes, const ArgValue* args) {
+    EventRing* ring = t_owner.ring;
+    if (ring == nullptr) {
+        // Retried on every call, as a ring may have been freed since
+        if ((ring = t_owner.ring = acquireRing()) == nullptr) {
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    // Single producer: only this thread ever advances head
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    EventRecord& record = ring->records[head & (kRingCapacity - 1)];
+    record.timestampNs = nowNs();
+    record.id = static_cast<uint16_t>(id);
+    record.level = static_cast<uint8_t>(level);
+    record.argCount = argCount;
+    record.argTypes = argTypes;
+    for (uint8_t i = 0; i < argCount; i++) {
+        record.args[i] = args[i];
+    }
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+std::string dump() {
+    struct Entry {
+        EventRecord record;
+        uint32_t threadId;
+    };
+    std::vector<Entry> entries;
+
+    int count = ringCount();
+    for (int i = 0; i < count; i++) {
+        EventRing* ring = g_rings[i].load(std::memory_order_acquire);
+        if (!ring) continue;
+
+        uint64_t end = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = std::min(firstRecord(ring, end), end);
+        uint32_t threadId = ring->threadId.load(std::memory_order_relaxed);
+        size_t first = entries.size();
+        for (uint64_t n = begin; n < end; n++) {
+            entries.push_back({ring->records[n & (kRingCapacity - 1)], threadId});
+        }
+
+        // The owner may have lapped us while copying; drop anything that
+        // could have been overwritten (seqlock-style validation)
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t headAfter = ring->head.load(std::memory_order_relaxed);
+        uint64_t oldestValid = headAfter + 1 > kRingCapacity ? headAfter + 1 - kRingCapacity : 0;
+        if (oldestValid > begin) {
+            size_t stale = static_cast<size_t>(std::min(oldestValid, end) - begin);
+            entries.erase(entries.begin() + first, entries.begin() + first + stale);
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.record.timestampNs < b.record.timestampNs;
+    });
+
+    std::string result;
+    result.reserve(entries.size() * 80);
+    char line[256];
+    for (const auto& entry : entries) {
+        formatRecord(entry.record, entry.threadId, line, sizeof(line));
+        result += line;
+        result += '\n';
+    }
+
+    uint32_t dropped = droppedRecords();
+    if (dropped > 0) {
+        snprintf(line, sizeof(line), "(%u records dropped: too many logging threads)\n", dropped);
+        result += line;
+    }
+    return result;
+}
+
+void installCrashHandler() {
+    t_altStack.install();
+    if (g_crashHandlerInstalled.exchange(true)) return;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_sigaction = crashHandler;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+
+    for (int i = 0; i < kCrashSignalCount; i++) {
+        sigaction(kCrashSignals[i], &action, &g_previousActions[i]);
+    }
+}
+
+uint32_t droppedRecords() {
+    return g_dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace eventlog
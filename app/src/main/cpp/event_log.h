@@ -0,0 +1,154 @@
+#ifndef TOUCHGAME_EVENT_LOG_H
+#define TOUCHGAME_EVENT_LOG_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+// Binary event log for hot paths.
+//
+// Each call site writes one fixed-size record (event id, timestamp, up to
+// four 32-bit arguments) into a lock-free ring buffer owned by the calling
+// thread. Nothing is formatted until the log is dumped, either on demand
+// (eventlog::dump, exposed through JNI) or from the crash handler.
+//
+// Levels below TG_LOG_LEVEL are removed by the preprocessor, so disabled
+// call sites cost nothing. Release builds (NDEBUG) default to INFO.
+
+#define TG_LOG_LEVEL_VERBOSE 0
+#define TG_LOG_LEVEL_DEBUG   1
+#define TG_LOG_LEVEL_INFO    2
+#define TG_LOG_LEVEL_WARN    3
+#define TG_LOG_LEVEL_ERROR   4
+#define TG_LOG_LEVEL_NONE    5
+
+#ifndef TG_LOG_LEVEL
+#ifdef NDEBUG
+#define TG_LOG_LEVEL TG_LOG_LEVEL_INFO
+#else
+#define TG_LOG_LEVEL TG_LOG_LEVEL_VERBOSE
+#endif
+#endif
+
+// Every event that can be recorded. The format string used when dumping
+// lives in the descriptor table in event_log.cpp and must stay in sync.
+enum class EventId : uint16_t {
+    GameInit,       // width, height, baseRadius
+    CircleReset,    // circles, radius, speed, round
+    CircleHit,      // score, points, remaining
+    TouchMiss,      // x, y
+    LevelComplete,  // round
+    GameReset,      //
+    LevelsLoaded,   // rounds, effects
+    LevelsMissing,  //
+    BallStyleSet,   // style (0 mesh, 1 impostor), supported
+    AutoplaySet,    // enabled, round, reaction ms, aim error px
+    ParticleModeSet, // mode (0 cpu, 1 gpu, 2 packed), supported
+    Count
+};
+
+namespace eventlog {
+
+enum ArgType : uint8_t {
+    ARG_INT = 0,
+    ARG_UINT = 1,
+    ARG_FLOAT = 2
+};
+
+union ArgValue {
+    int32_t i;
+    uint32_t u;
+    float f;
+};
+
+// 32 bytes, so two records share a cache line
+struct EventRecord {
+    uint64_t timestampNs; // CLOCK_MONOTONIC
+    uint16_t id;
+    uint8_t level;
+    uint8_t argCount;
+    uint8_t argTypes;     // 2 bits per argument
+    uint8_t reserved[3];
+    ArgValue args[4];
+};
+
+static_assert(sizeof(EventRecord) == 32, "EventRecord must stay 32 bytes");
+
+void write(int level, EventId id, uint8_t argCount, uint8_t argTypes, const ArgValue* args);
+
+// Formats every buffered record, oldest first, one per line.
+std::string dump();
+
+// Installs fatal-signal handlers that write the formatted log to logcat
+// (stderr on host builds) before the process dies. Safe to call repeatedly.
+// The handler runs on an alternate stack, which the calling thread and
+// every logging thread get, so stack overflows are reported too.
+void installCrashHandler();
+
+// Records dropped because more live threads logged than there are ring
+// slots. A thread's ring is released when it exits and reused by the next.
+uint32_t droppedRecords();
+
+template <typename T>
+inline void pack(ArgValue* args, uint8_t& types, int index, T value) {
+    static_assert(std::is_arithmetic<T>::value, "event arguments must be numbers");
+    if (std::is_floating_point<T>::value) {
+        args[index].f = static_cast<float>(value);
+        types |= ARG_FLOAT << (index * 2);
+    } else if (std::is_signed<T>::value) {
+        args[index].i = static_cast<int32_t>(value);
+        types |= ARG_INT << (index * 2);
+    } else {
+        args[index].u = static_cast<uint32_t>(value);
+        types |= ARG_UINT << (index * 2);
+    }
+}
+
+inline void record(int level, EventId id) {
+    write(level, id, 0, 0, nullptr);
+}
+
+template <typename... Args>
+inline void record(int level, EventId id, Args... values) {
+    static_assert(sizeof...(Args) <= 4, "events carry at most four arguments");
+    ArgValue args[4];
+    uint8_t types = 0;
+    int index = 0;
+    (void)std::initializer_list<int>{(pack(args, types, index++, values), 0)...};
+    write(level, id, static_cast<uint8_t>(sizeof...(Args)), types, args);
+}
+
+} // namespace eventlog
+
+#if TG_LOG_LEVEL <= TG_LOG_LEVEL_VERBOSE
+#define ELOGV(...) ::eventlog::record(TG_LOG_LEVEL_VERBOSE, __VA_ARGS__)
+#else
+#define ELOGV(...) ((void)0)
+#endif
+
+#if TG_LOG_LEVEL <= TG_LOG_LEVEL_DEBUG
+#define ELOGD(...) ::eventlog::record(TG_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define ELOGD(...) ((void)0)
+#endif
+
+#if TG_LOG_LEVEL <= TG_LOG_LEVEL_INFO
+#define ELOGI(...) ::eventlog::record(TG_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define ELOGI(...) ((void)0)
+#endif
+
+#if TG_LOG_LEVEL <= TG_LOG_LEVEL_WARN
+#define ELOGW(...) ::eventlog::record(TG_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define ELOGW(...) ((void)0)
+#endif
+
+#if TG_LOG_LEVEL <= TG_LOG_LEVEL_ERROR
+#define ELOGE(...) ::eventlog::record(TG_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define ELOGE(...) ((void)0)
+#endif
+
+#endif // TOUCHGAME_EVENT_LOG_H
@@ -1,54 +1,23 @@
 #include "game.h"
+#include "event_log.h"
+#include "level_table.h"
+#include "render_backend.h"
 #include <cmath>
-#include <android/log.h>
+#include <cstdio>
 
-#define LOG_TAG "TouchGame"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+// Seconds after which the GPU particle clock is moved back to 0; a float
+// at 1024 still resolves 0.1 ms
+static const float PARTICLE_CLOCK_REBASE = 1024.0f;
 
-const char* vertexShaderSource = R"(
-    attribute vec2 position;
-    uniform mat4 mvp;
-    void main() {
-        gl_Position = mvp * vec4(position, 0.0, 1.0);
-    }
-)";
-
-const char* fragmentShaderSource = R"(
-    precision mediump float;
-    uniform vec4 color;
-    void main() {
-        gl_FragColor = color;
-    }
-)";
-
-const char* gradientVertexShaderSource = R"(
-    attribute vec2 position;
-    varying vec2 vPosition;
-    void main() {
-        gl_Position = vec4(position, 0.0, 1.0);
-        vPosition = position;
-    }
-)";
-
-const char* gradientFragmentShaderSource = R"(
-    precision mediump float;
-    varying vec2 vPosition;
-    uniform vec4 color1;
-    uniform vec4 color2;
-    void main() {
-        float gradient = (vPosition.y + 1.0) * 0.5;
-        gl_FragColor = mix(color1, color2, gradient);
-    }
-)";
+Game::Game() : Game(static_cast<uint32_t>(
+                   std::chrono::high_resolution_clock::now().time_since_epoch().count())) {
+}
 
-Game::Game() : score(0), round(1), gameOver(false), baseSpeed(500.0f), 
-               baseRadius(0.0f), shaderProgram(0), vbo(0),
-               gradientShaderProgram(0), gradientVbo(0) {
-    auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+Game::Game(uint32_t seed) : particleMode(PARTICLE_MODE_CPU), particleClock(0.0f),
+               levels(&LevelTable::fallback()), baseRadius(0.0f), score(0), round(1), gameOver(false) {
     rng.seed(seed);
     distAngle = std::uniform_real_distribution<float>(0, 2 * M_PI);
     distColor = std::uniform_real_distribution<float>(0.0f, 1.0f);
-    distDecoyCount = std::uniform_int_distribution<int>(1, 10);
     // Initialize with light gradient
     bgColorR1 = 0.9f;
     bgColorG1 = 0.9f;
@@ -59,99 +28,45 @@ Game::Game() : score(0), round(1), gameOver(false), baseSpeed(500.0f),
 }
 
 Game::~Game() {
-    if (shaderProgram) {
-        glDeleteProgram(shaderProgram);
-    }
-    if (vbo) {
-        glDeleteBuffers(1, &vbo);
-    }
-    if (gradientShaderProgram) {
-        glDeleteProgram(gradientShaderProgram);
-    }
-    if (gradientVbo) {
-        glDeleteBuffers(1, &gradientVbo);
-    }
+}
+
+void Game::setLevelTable(const LevelTable* table) {
+    levels = table != nullptr ? table : &LevelTable::fallback();
+}
+
+void Game::setParticleMode(ParticleMode mode) {
+    particleMode = mode;
+    particles.clear();
+    packedParticles.clear();
+    particleSpawns.clear();
+    particleClock = 0.0f;
 }
 
 void Game::init(int width, int height) {
     screenWidth = width;
     screenHeight = height;
     
-    // Set base radius proportional to screen size (10% of smaller dimension)
+    // Set base radius proportional to screen size (round 1 of the level table)
     float minDimension = (width < height) ? width : height;
-    baseRadius = minDimension * 0.10f;
+    baseRadius = minDimension * levels->round(1).radius;
     
     distX = std::uniform_real_distribution<float>(baseRadius, width - baseRadius);
     distY = std::uniform_real_distribution<float>(baseRadius, height - baseRadius);
     distAngle = std::uniform_real_distribution<float>(0.0f, 2.0f * M_PI);
     
-    setupShaders();
+    hud.init(width, height);
     resetCircle();
     
-    LOGI("Game initialized: %dx%d, baseRadius: %.1f", width, height, baseRadius);
-}
-
-void Game::setupShaders() {
-    // Compile vertex shader
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-    
-    // Compile fragment shader
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-    
-    // Link program
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    
-    // Get attribute and uniform locations
-    positionLoc = glGetAttribLocation(shaderProgram, "position");
-    colorLoc = glGetUniformLocation(shaderProgram, "color");
-    mvpLoc = glGetUniformLocation(shaderProgram, "mvp");
-    
-    // Create VBO
-    glGenBuffers(1, &vbo);
-    
-    // Setup gradient shader
-    GLuint gradientVertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(gradientVertexShader, 1, &gradientVertexShaderSource, nullptr);
-    glCompileShader(gradientVertexShader);
-    
-    GLuint gradientFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(gradientFragmentShader, 1, &gradientFragmentShaderSource, nullptr);
-    glCompileShader(gradientFragmentShader);
-    
-    gradientShaderProgram = glCreateProgram();
-    glAttachShader(gradientShaderProgram, gradientVertexShader);
-    glAttachShader(gradientShaderProgram, gradientFragmentShader);
-    glLinkProgram(gradientShaderProgram);
-    
-    glDeleteShader(gradientVertexShader);
-    glDeleteShader(gradientFragmentShader);
-    
-    gradientPositionLoc = glGetAttribLocation(gradientShaderProgram, "position");
-    gradientColor1Loc = glGetUniformLocation(gradientShaderProgram, "color1");
-    gradientColor2Loc = glGetUniformLocation(gradientShaderProgram, "color2");
-    
-    glGenBuffers(1, &gradientVbo);
+    ELOGI(EventId::GameInit, width, height, baseRadius);
 }
 
 void Game::resetCircle() {
     circles.clear();
     
-    // Shrink circle by 5% each round (minimum 3% of screen size)
+    // Size, speed and circle count come from the level table
+    const RoundDef& def = levels->round(round);
     float minDimension = (screenWidth < screenHeight) ? screenWidth : screenHeight;
-    float minRadius = minDimension * 0.03f;
-    
-    float circleRadius = baseRadius * powf(0.95f, round - 1);
-    if (circleRadius < minRadius) circleRadius = minRadius;
+    float circleRadius = minDimension * def.radius;
     
     // Update distributions with new radius
     distX = std::uniform_real_distribution<float>(circleRadius, screenWidth - circleRadius);
@@ -168,15 +83,13 @@ void Game::resetCircle() {
     // Calculate average background brightness
     float avgBrightness = (bgColorR1 + bgColorG1 + bgColorB1 + bgColorR2 + bgColorG2 + bgColorB2) / 6.0f;
     
-    float speed = baseSpeed * (1.0f + (round - 1) * 0.2f);
+    float speed = levels->speedForRound(round);
     
-    // Number of circles increases with each level
-    int totalCircles;
-    if (round < 11) {
-        totalCircles = round;
-    } else {
-        // From level 11 onwards, random 2-10 circles
-        totalCircles = 2 + (rand() % 9); // 2-10 circles
+    // Fixed count, or drawn from rng (not rand()) so seeded games are
+    // reproducible and independent across threads
+    int totalCircles = def.circlesMin;
+    if (def.circlesMax > def.circlesMin) {
+        totalCircles = std::uniform_int_distribution<int>(def.circlesMin, def.circlesMax)(rng);
     }
     
     // Create all circles
@@ -186,7 +99,6 @@ void Game::resetCircle() {
         circle.y = distY(rng);
         circle.radius = circleRadius;
         circle.flashTimer = 0.0f;
-        circle.isDecoy = false; // All circles are valid targets
         
         // Generate contrasting circle color (dark if bg is bright, bright if bg is dark)
         if (avgBrightness > 0.5f) {
@@ -208,14 +120,10 @@ void Game::resetCircle() {
         circles.push_back(circle);
     }
     
-    LOGI("Circle reset: %d circles, radius=%.1f, speed=%.1f, round=%d", 
-         totalCircles, circleRadius, speed, round);
+    ELOGI(EventId::CircleReset, totalCircles, circleRadius, speed, round);
 }
 
-void Game::update(float deltaTime) {
-    if (gameOver) return;
-    
-    // Update all circles
+void updateCircles(std::vector<Circle>& circles, float deltaTime, int screenWidth, int screenHeight) {
     for (auto& circle : circles) {
         // Update position
         circle.x += circle.velocityX * deltaTime;
@@ -237,279 +145,85 @@ void Game::update(float deltaTime) {
             circle.y = std::max(circle.radius, std::min(circle.y, screenHeight - circle.radius));
         }
     }
-    
-    // Update particles
-    for (auto it = particles.begin(); it != particles.end();) {
-        it->x += it->velocityX * deltaTime;
-        it->y += it->velocityY * deltaTime;
-        it->velocityY += 600.0f * deltaTime; // Gravity
-        it->lifetime += deltaTime;
-        
-        // Remove dead particles
-        if (it->lifetime >= it->maxLifetime) {
-            it = particles.erase(it);
-        } else {
-            ++it;
-        }
-    }
 }
 
-void Game::render() {
-    glClear(GL_COLOR_BUFFER_BIT);
-    
-    // Render gradient background
-    glUseProgram(gradientShaderProgram);
-    
-    // Full screen quad vertices in normalized device coordinates
-    float quadVertices[] = {
-        -1.0f, -1.0f,  // Bottom left
-         1.0f, -1.0f,  // Bottom right
-        -1.0f,  1.0f,  // Top left
-         1.0f,  1.0f   // Top right
-    };
-    
-    glBindBuffer(GL_ARRAY_BUFFER, gradientVbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
-    
-    glEnableVertexAttribArray(gradientPositionLoc);
-    glVertexAttribPointer(gradientPositionLoc, 2, GL_FLOAT, GL_FALSE, 0, 0);
-    
-    // Set gradient colors
-    glUniform4f(gradientColor1Loc, bgColorR1, bgColorG1, bgColorB1, 1.0f);
-    glUniform4f(gradientColor2Loc, bgColorR2, bgColorG2, bgColorB2, 1.0f);
-    
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glDisableVertexAttribArray(gradientPositionLoc);
-    
-    // Render all circles
-    for (const auto& circle : circles) {
-        renderCircle(circle);
-    }
-    
-    // Render all particles
-    for (const auto& particle : particles) {
-        renderParticle(particle);
-    }
-}
-
-void Game::renderCircle(const Circle& circle) {
-    glUseProgram(shaderProgram);
-    
-    // Create orthographic projection matrix
-    float left = 0.0f;
-    float right = static_cast<float>(screenWidth);
-    float bottom = static_cast<float>(screenHeight);
-    float top = 0.0f;
-    float near = -1.0f;
-    float far = 1.0f;
-    
-    float ortho[16] = {
-        2.0f / (right - left), 0.0f, 0.0f, 0.0f,
-        0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
-        0.0f, 0.0f, -2.0f / (far - near), 0.0f,
-        -(right + left) / (right - left), -(top + bottom) / (top - bottom), -(far + near) / (far - near), 1.0f
-    };
-    
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, ortho);
-    
-    // Draw 3D ball with realistic lighting and shading
-    const int segments = 48;
-    const int rings = 24; // More rings for ultra-smooth gradient
-    
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glEnableVertexAttribArray(positionLoc);
-    glVertexAttribPointer(positionLoc, 2, GL_FLOAT, GL_FALSE, 0, 0);
-    
-    // Light position (center of screen)
-    float screenCenterX = screenWidth / 2.0f;
-    float screenCenterY = screenHeight / 2.0f;
-    
-    // Calculate direction from circle to light
-    float toLightX = screenCenterX - circle.x;
-    float toLightY = screenCenterY - circle.y;
-    float toLightDist = sqrtf(toLightX * toLightX + toLightY * toLightY);
-    
-    // Normalize and scale to create highlight offset
-    float lightOffsetX, lightOffsetY;
-    if (toLightDist > 0.01f) {
-        float normalizedX = toLightX / toLightDist;
-        float normalizedY = toLightY / toLightDist;
-        lightOffsetX = normalizedX * circle.radius * 0.3f;
-        lightOffsetY = normalizedY * circle.radius * 0.3f;
-    } else {
-        // Circle is at screen center, default to top offset
-        lightOffsetX = 0.0f;
-        lightOffsetY = -circle.radius * 0.3f;
-    }
+void Game::update(float deltaTime) {
+    if (gameOver) return;
     
-    // Draw from center to outer edge with spherical gradient
-    for (int ring = 0; ring < rings; ring++) {
-        float innerRadius = (ring / (float)rings) * circle.radius;
-        float outerRadius = ((ring + 1) / (float)rings) * circle.radius;
-        
-        float vertices[(segments + 1) * 4];
-        int vertexIndex = 0;
-        
-        for (int i = 0; i <= segments; i++) {
-            float angle = 2.0f * M_PI * i / segments;
-            float cosAngle = cos(angle);
-            float sinAngle = sin(angle);
-            
-            // Inner vertex
-            vertices[vertexIndex++] = circle.x + innerRadius * cosAngle;
-            vertices[vertexIndex++] = circle.y + innerRadius * sinAngle;
-            
-            // Outer vertex
-            vertices[vertexIndex++] = circle.x + outerRadius * cosAngle;
-            vertices[vertexIndex++] = circle.y + outerRadius * sinAngle;
-        }
-        
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-        
-        // Calculate distance from light position for each ring
-        float ringCenterRadius = (innerRadius + outerRadius) / 2.0f;
-        
-        // Simulate spherical lighting using distance from light
-        // For each point on the ring, calculate brightness based on sphere geometry
-        float normalizedRadius = ringCenterRadius / circle.radius;
-        
-        // Spherical brightness calculation with smoother transitions
-        // z = sqrt(1 - x² - y²) for a sphere, simplified for 2D circle
-        float z = sqrtf(fmax(0.0f, 1.0f - normalizedRadius * normalizedRadius));
-        
-        // Distance from light position (offset highlight)
-        float lightDist = sqrtf(
-            (lightOffsetX * lightOffsetX + lightOffsetY * lightOffsetY) / 
-            (circle.radius * circle.radius)
-        );
-        
-        // Enhanced brightness calculation with smoother falloff
-        float brightness;
-        if (ring == 0) {
-            // Brightest specular highlight at center
-            brightness = 2.4f;
-        } else if (normalizedRadius < 0.15f) {
-            // Very bright core area with smooth transition
-            float t = normalizedRadius / 0.15f;
-            brightness = 2.4f - t * 0.6f; // 2.4 to 1.8
-        } else if (normalizedRadius < 0.35f) {
-            // Bright highlight area
-            float t = (normalizedRadius - 0.15f) / 0.2f;
-            brightness = 1.8f - t * 0.4f; // 1.8 to 1.4
-        } else if (normalizedRadius < 0.6f) {
-            // Mid-tones with gradual falloff
-            float t = (normalizedRadius - 0.35f) / 0.25f;
-            t = t * t; // Quadratic for smoother transition
-            brightness = 1.4f - t * 0.35f; // 1.4 to 1.05
-        } else if (normalizedRadius < 0.85f) {
-            // Shadow area
-            float t = (normalizedRadius - 0.6f) / 0.25f;
-            t = t * t; // Quadratic for smoother transition
-            brightness = 1.05f - t * 0.35f; // 1.05 to 0.7
-        } else {
-            // Dark edge with smooth ambient occlusion
-            float t = (normalizedRadius - 0.85f) / 0.15f;
-            t = t * t * t; // Cubic for very smooth edge
-            brightness = 0.7f - t * 0.35f; // 0.7 to 0.35
-            
-            // Enhanced rim lighting effect
-            if (normalizedRadius > 0.9f) {
-                float rimStrength = (normalizedRadius - 0.9f) / 0.1f;
-                rimStrength = rimStrength * rimStrength; // Quadratic for smooth rim
-                brightness += rimStrength * 0.25f; // Stronger rim light
-            }
-        }
-        
-        // Add ambient light so it's never completely black
-        brightness = brightness * 0.88f + 0.12f;
-        
-        // Add flash effect when circle is touched
-        if (circle.flashTimer > 0.0f) {
-            float flashStrength = circle.flashTimer / 0.15f; // 0.15 second flash duration
-            brightness += flashStrength * 0.8f; // Bright flash
+    updateCircles(circles, deltaTime, screenWidth, screenHeight);
+    
+    // Update particles; in GPU mode the shader works out where they are
+    if (particleMode == PARTICLE_MODE_GPU) {
+        particleClock += deltaTime;
+        particleSpawns.retire(particleClock);
+        // Spawn ages are float differences on this clock; past a few
+        // thousand seconds a 1/60 s step would lose precision, so restart
+        // it whenever the ring empties and shift the live records otherwise
+        if (particleSpawns.size() == 0) {
+            particleClock = 0.0f;
+        } else if (particleClock > PARTICLE_CLOCK_REBASE) {
+            particleSpawns.rebase(particleClock);
+            particleClock = 0.0f;
         }
-        
-        // Apply brightness to color
-        float r = circle.colorR * brightness;
-        float g = circle.colorG * brightness;
-        float b = circle.colorB * brightness;
-        
-        // Clamp values
-        r = r > 1.0f ? 1.0f : r;
-        g = g > 1.0f ? 1.0f : g;
-        b = b > 1.0f ? 1.0f : b;
-        
-        glUniform4f(colorLoc, r, g, b, 1.0f);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, (segments + 1) * 2);
-    }
-    
-    // Add glossy highlight spot with smoother edges
-    const int highlightSegments = 28;
-    float highlightRadius = circle.radius * 0.22f;
-    float highlightX = circle.x + lightOffsetX;
-    float highlightY = circle.y + lightOffsetY;
-    
-    float highlightVertices[highlightSegments * 2 + 4];
-    highlightVertices[0] = highlightX;
-    highlightVertices[1] = highlightY;
-    
-    for (int i = 0; i <= highlightSegments; i++) {
-        float angle = 2.0f * M_PI * i / highlightSegments;
-        highlightVertices[2 + i * 2] = highlightX + highlightRadius * cos(angle);
-        highlightVertices[3 + i * 2] = highlightY + highlightRadius * sin(angle);
+    } else if (particleMode == PARTICLE_MODE_PACKED) {
+        updatePackedParticles(packedParticles, deltaTime, levels->getGravity(), screenHeight);
+    } else {
+        updateParticles(particles, deltaTime, levels->getGravity());
     }
-    
-    glBufferData(GL_ARRAY_BUFFER, sizeof(highlightVertices), highlightVertices, GL_DYNAMIC_DRAW);
-    
-    // White glossy highlight with some transparency
-    glUniform4f(colorLoc, 1.0f, 1.0f, 1.0f, 0.6f);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, highlightSegments + 2);
-    glDisable(GL_BLEND);
-    
-    glDisableVertexAttribArray(positionLoc);
 }
 
-void Game::renderParticle(const Particle& particle) {
-    glUseProgram(shaderProgram);
-    
-    float ortho[16] = {
-        2.0f / screenWidth, 0.0f, 0.0f, 0.0f,
-        0.0f, 2.0f / screenHeight, 0.0f, 0.0f,
-        0.0f, 0.0f, -2.0f, 0.0f,
-        -1.0f, -1.0f, 0.0f, 1.0f
-    };
-    
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, ortho);
-    
-    // Draw particle as a small square
-    float halfSize = particle.size / 2.0f;
-    float vertices[] = {
-        particle.x - halfSize, particle.y - halfSize,
-        particle.x + halfSize, particle.y - halfSize,
-        particle.x + halfSize, particle.y + halfSize,
-        particle.x - halfSize, particle.y + halfSize
-    };
-    
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-    
-    glEnableVertexAttribArray(positionLoc);
-    glVertexAttribPointer(positionLoc, 2, GL_FLOAT, GL_FALSE, 0, 0);
-    
-    // Fade out based on lifetime
-    float alpha = 1.0f - (particle.lifetime / particle.maxLifetime);
-    glUniform4f(colorLoc, particle.colorR, particle.colorG, particle.colorB, alpha);
-    
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    
-    glDisableVertexAttribArray(positionLoc);
+void Game::render(RenderBackend& backend) {
+    // Score and round on top; dark text on bright backgrounds
+    float luminance = (0.299f * (bgColorR1 + bgColorR2) +
+                       0.587f * (bgColorG1 + bgColorG2) +
+                       0.114f * (bgColorB1 + bgColorB2)) / 2.0f;
+    hud.setValues(score, round, luminance > 0.5f);
+    
+    FrameData frame;
+    frame.screenWidth = screenWidth;
+    frame.screenHeight = screenHeight;
+    frame.bgColor1[0] = bgColorR1;
+    frame.bgColor1[1] = bgColorG1;
+    frame.bgColor1[2] = bgColorB1;
+    frame.bgColor2[0] = bgColorR2;
+    frame.bgColor2[1] = bgColorG2;
+    frame.bgColor2[2] = bgColorB2;
+    frame.circles = &circles;
+    frame.particles = &particles;
+    frame.packedParticles = &packedParticles;
+    frame.particleSpawns = &particleSpawns;
+    frame.particleTime = particleClock;
+    frame.hud = &hud;
+    backend.drawFrame(frame);
 }
 
 void Game::createExplosion(float x, float y, float radius, float r, float g, float b) {
-    // Create 20-30 particles flying outward
-    int numParticles = 20 + (rand() % 11);
+    // Particles flying outward, shaped by the round's effect
+    const EffectDef& effect = levels->effect(levels->round(round).effect);
+    int numParticles = std::uniform_int_distribution<int>(effect.particlesMin, effect.particlesMax)(rng);
+    
+    if (particleMode == PARTICLE_MODE_GPU) {
+        // One record; the vertex shader draws the per-particle variation
+        ParticleSpawn& spawn = particleSpawns.spawn();
+        spawn.x = x;
+        spawn.y = y;
+        spawn.spawnTime = particleClock;
+        spawn.seed = static_cast<float>(std::uniform_int_distribution<int>(0, 65535)(rng));
+        spawn.colorR = r;
+        spawn.colorG = g;
+        spawn.colorB = b;
+        spawn.colorJitter = effect.colorJitter;
+        spawn.sizeMin = radius * effect.sizeMin;
+        spawn.sizeMax = radius * effect.sizeMax;
+        spawn.speedMin = effect.speedMin;
+        spawn.speedMax = effect.speedMax;
+        spawn.upwardBias = effect.upwardBias;
+        spawn.gravity = levels->getGravity();
+        spawn.lifetimeMin = effect.lifetimeMin;
+        spawn.lifetimeMax = effect.lifetimeMax;
+        spawn.count = static_cast<uint32_t>(numParticles);
+        return;
+    }
     
     for (int i = 0; i < numParticles; i++) {
         Particle p;
@@ -518,22 +232,27 @@ void Game::createExplosion(float x, float y, float radius, float r, float g, flo
         
         // Random direction
         float angle = distAngle(rng);
-        float speed = 200.0f + distColor(rng) * 400.0f; // 200-600 px/s
+        float speed = effect.speedMin + distColor(rng) * (effect.speedMax - effect.speedMin);
         
         p.velocityX = cos(angle) * speed;
-        p.velocityY = sin(angle) * speed - 200.0f; // Initial upward bias
+        p.velocityY = sin(angle) * speed - effect.upwardBias; // Initial upward bias
         
-        p.size = radius * 0.15f + distColor(rng) * radius * 0.1f; // Variable sizes
+        // Variable sizes
+        p.size = radius * effect.sizeMin + distColor(rng) * radius * (effect.sizeMax - effect.sizeMin);
         
         // Slight color variation
-        p.colorR = std::min(1.0f, r + (distColor(rng) - 0.5f) * 0.2f);
-        p.colorG = std::min(1.0f, g + (distColor(rng) - 0.5f) * 0.2f);
-        p.colorB = std::min(1.0f, b + (distColor(rng) - 0.5f) * 0.2f);
+        p.colorR = std::min(1.0f, r + (distColor(rng) - 0.5f) * effect.colorJitter);
+        p.colorG = std::min(1.0f, g + (distColor(rng) - 0.5f) * effect.colorJitter);
+        p.colorB = std::min(1.0f, b + (distColor(rng) - 0.5f) * effect.colorJitter);
         
         p.lifetime = 0.0f;
-        p.maxLifetime = 0.5f + distColor(rng) * 0.5f; // 0.5-1.0 seconds
+        p.maxLifetime = effect.lifetimeMin + distColor(rng) * (effect.lifetimeMax - effect.lifetimeMin);
         
-        particles.push_back(p);
+        if (particleMode == PARTICLE_MODE_PACKED) {
+            packedParticles.push_back(packParticle(p, screenWidth, screenHeight));
+        } else {
+            particles.push_back(p);
+        }
     }
 }
 
@@ -554,7 +273,7 @@ bool Game::handleTouch(float touchX, float touchY) {
             int points = 10;
             score += points;
             
-            LOGI("Hit circle! Score: %d (+%d), Remaining: %zu", score, points, circles.size() - 1);
+            ELOGI(EventId::CircleHit, score, points, static_cast<int>(circles.size()) - 1);
             
             // Remove the touched circle
             circles.erase(circles.begin() + i);
@@ -563,7 +282,7 @@ bool Game::handleTouch(float touchX, float touchY) {
             if (circles.empty()) {
                 // Level complete - advance to next round
                 round++;
-                LOGI("Level complete! Advancing to round %d", round);
+                ELOGI(EventId::LevelComplete, round);
                 
                 // Show toast message
                 if (toastCallback) {
@@ -579,6 +298,7 @@ bool Game::handleTouch(float touchX, float touchY) {
         }
     }
     
+    ELOGV(EventId::TouchMiss, touchX, touchY);
     return false;
 }
 
@@ -593,10 +313,16 @@ bool Game::checkCollision(float touchX, float touchY, const Circle& circle) {
     return distance <= touchRadius;
 }
 
+void Game::startRound(int newRound) {
+    round = newRound > 1 ? newRound : 1;
+    gameOver = false;
+    resetCircle();
+}
+
 void Game::reset() {
     score = 0;
     round = 1;
     gameOver = false;
     resetCircle();
-    LOGI("Game reset");
+    ELOGI(EventId::GameReset);
 }
@@ -1,28 +1,22 @@
 #ifndef TOUCHGAME_GAME_H
 #define TOUCHGAME_GAME_H
 
-#include <GLES2/gl2.h>
+#include <cstdint>
 #include <random>
 #include <chrono>
 #include <vector>
 #include <functional>
+#include <string>
+#include "hud.h"
+#include "packed_entities.h"
+#include "particles.h"
+
+class LevelTable;
+class RenderBackend;
 
 // Callback function type for showing toasts
 typedef std::function<void(const char*)> ToastCallback;
 
-struct Particle {
-    float x;
-    float y;
-    float velocityX;
-    float velocityY;
-    float size;
-    float colorR;
-    float colorG;
-    float colorB;
-    float lifetime; // seconds
-    float maxLifetime;
-};
-
 struct Circle {
     float x;
     float y;
@@ -32,26 +26,42 @@ struct Circle {
     float colorR;
     float colorG;
     float colorB;
-    bool isDecoy; // true = explodes, false = scores points
     float flashTimer; // for visual feedback on touch
 };
 
+// Moves every circle one step, bouncing off the screen edges
+void updateCircles(std::vector<Circle>& circles, float deltaTime, int screenWidth, int screenHeight);
+
 class Game {
 public:
     Game();
+    explicit Game(uint32_t seed); // deterministic, for headless simulation
     ~Game();
     
     void init(int screenWidth, int screenHeight);
     void update(float deltaTime);
-    void render();
+    void render(RenderBackend& backend);
     bool handleTouch(float x, float y);
     void reset();
+    // Jumps straight to a round with a fresh layout, score kept (soak tests,
+    // benchmarks of late rounds)
+    void startRound(int newRound);
     
     void setToastCallback(ToastCallback callback) { toastCallback = callback; }
+    // Difficulty curve and effects; LevelTable::fallback() until set. The
+    // table must outlive the game and is read every round, never copied.
+    void setLevelTable(const LevelTable* table);
+    // CPU by default; the others only for backends that support them.
+    // Switching drops the explosions in flight.
+    void setParticleMode(ParticleMode mode);
+    ParticleMode getParticleMode() const { return particleMode; }
     
     int getScore() const { return score; }
     int getRound() const { return round; }
     bool isGameOver() const { return gameOver; }
+    const std::vector<Circle>& getCircles() const { return circles; }
+    int getScreenWidth() const { return screenWidth; }
+    int getScreenHeight() const { return screenHeight; }
     float getBgColorR1() const { return bgColorR1; }
     float getBgColorG1() const { return bgColorG1; }
     float getBgColorB1() const { return bgColorB1; }
@@ -62,17 +72,18 @@ public:
 private:
     void resetCircle();
     bool checkCollision(float touchX, float touchY, const Circle& circle);
-    void setupShaders();
-    void renderCircle(const Circle& circle);
-    void renderParticle(const Particle& particle);
     void createExplosion(float x, float y, float radius, float r, float g, float b);
     
     // Multiple circles support
     std::vector<Circle> circles;
-    std::vector<Particle> particles;
+    std::vector<Particle> particles;       // CPU mode
+    std::vector<PackedParticle> packedParticles; // PACKED mode
+    ParticleSpawnRing particleSpawns;      // GPU mode
+    ParticleMode particleMode;
+    float particleClock;                   // seconds; spawn times are on it, kept small by update()
     
     // Circle properties
-    float baseSpeed;
+    const LevelTable* levels;
     float baseRadius;
     float bgColorR1;
     float bgColorG1;
@@ -96,19 +107,9 @@ private:
     std::uniform_real_distribution<float> distY;
     std::uniform_real_distribution<float> distAngle;
     std::uniform_real_distribution<float> distColor;
-    std::uniform_int_distribution<int> distDecoyCount;
     
-    // OpenGL resources
-    GLuint shaderProgram;
-    GLuint vbo;
-    GLint positionLoc;
-    GLint colorLoc;
-    GLint mvpLoc;
-    GLuint gradientShaderProgram;
-    GLuint gradientVbo;
-    GLint gradientPositionLoc;
-    GLint gradientColor1Loc;
-    GLint gradientColor2Loc;
+    // Score/round overlay
+    Hud hud;
     
     // Callback for showing toast messages
     ToastCallback toastCallback;
@@ -0,0 +1,201 @@
+#include "gl_state.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const char* const kCallNames[GlState::CALL_COUNT] = {
+    "useProgram",
+    "bindBuffer",
+    "attribArray",
+    "attribPointer",
+    "blend",
+    "blendFunc",
+    "activeTexture",
+    "bindTexture",
+    "uniform",
+};
+
+static const int kTextureUnits = 8;
+
+void GlState::invalidate() {
+    program = UNKNOWN;
+    arrayBuffer = UNKNOWN;
+    enabledAttribs = 0;
+    attribsKnown = false;
+    for (AttribPointer& pointer : pointers) {
+        pointer.valid = false;
+    }
+    blend = -1;
+    blendSource = GL_NONE;
+    blendDestination = GL_NONE;
+    activeUnit = UNKNOWN;
+    for (GLuint& texture : texture2D) {
+        texture = UNKNOWN;
+    }
+    uniforms.clear();
+    programUniforms = nullptr;
+}
+
+void GlState::resetCounters() {
+    memset(issued, 0, sizeof(issued));
+    memset(elided, 0, sizeof(elided));
+}
+
+void GlState::useProgram(GLuint newProgram) {
+    if (!count(CALL_USE_PROGRAM, newProgram != program)) return;
+    glUseProgram(newProgram);
+    program = newProgram;
+    programUniforms = &uniforms[newProgram];
+}
+
+void GlState::bindArrayBuffer(GLuint buffer) {
+    if (!count(CALL_BIND_BUFFER, buffer != arrayBuffer)) return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    arrayBuffer = buffer;
+}
+
+void GlState::setAttribArrays(uint32_t mask) {
+    if (attribLimit == 0) {
+        // GLES2 only guarantees 8; indices past the limit are GL_INVALID_VALUE
+        GLint limit = 0;
+        glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &limit);
+        attribLimit = limit > 0 ? std::min(static_cast<GLuint>(limit), MAX_ATTRIBS) : 8;
+    }
+    uint32_t supported = (1u << attribLimit) - 1;
+    mask &= supported;
+
+    // After invalidate() every attribute is set once explicitly
+    uint32_t changed = attribsKnown ? (mask ^ enabledAttribs) : supported;
+    if (changed == 0) {
+        count(CALL_ATTRIB_ARRAY, false);
+        return;
+    }
+    for (GLuint index = 0; index < attribLimit; index++) {
+        uint32_t bit = 1u << index;
+        if (!(changed & bit)) continue;
+        count(CALL_ATTRIB_ARRAY, true);
+        if (mask & bit) {
+            glEnableVertexAttribArray(index);
+        } else {
+            glDisableVertexAttribArray(index);
+        }
+    }
+    enabledAttribs = mask;
+    attribsKnown = true;
+}
+
+void GlState::attribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+                            size_t offset) {
+    if (index >= MAX_ATTRIBS) return;
+
+    AttribPointer& pointer = pointers[index];
+    bool changed = !pointer.valid || pointer.buffer != arrayBuffer || pointer.size != size ||
+                   pointer.type != type || pointer.normalized != normalized ||
+                   pointer.stride != stride || pointer.offset != offset;
+    if (!count(CALL_ATTRIB_POINTER, changed)) return;
+    glVertexAttribPointer(index, size, type, normalized, stride, reinterpret_cast<const void*>(offset));
+    pointer = AttribPointer{arrayBuffer, size, type, normalized, stride, offset, arrayBuffer != UNKNOWN};
+}
+
+void GlState::setBlend(bool enabled) {
+    int wanted = enabled ? 1 : 0;
+    if (!count(CALL_BLEND, wanted != blend)) return;
+    if (enabled) {
+        glEnable(GL_BLEND);
+    } else {
+        glDisable(GL_BLEND);
+    }
+    blend = wanted;
+}
+
+void GlState::blendFunc(GLenum source, GLenum destination) {
+    if (!count(CALL_BLEND_FUNC, source != blendSource || destination != blendDestination)) return;
+    glBlendFunc(source, destination);
+    blendSource = source;
+    blendDestination = destination;
+}
+
+void GlState::bindTexture2D(GLuint unit, GLuint texture) {
+    if (unit >= kTextureUnits) return;
+
+    if (count(CALL_ACTIVE_TEXTURE, unit != activeUnit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        activeUnit = unit;
+    }
+    if (count(CALL_BIND_TEXTURE, texture != texture2D[unit])) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        texture2D[unit] = texture;
+    }
+}
+
+bool GlState::uniformChanged(GLint location, const GLfloat* values, int size) {
+    // Program unknown: nothing to compare against
+    if (programUniforms == nullptr) return true;
+    // Inactive uniform; GL ignores the call
+    if (location < 0) return false;
+
+    std::vector<UniformSlot>& slots = *programUniforms;
+    if (static_cast<size_t>(location) >= slots.size()) {
+        slots.resize(location + 1, UniformSlot{{0}, false});
+    }
+    UniformSlot& slot = slots[location];
+    if (slot.valid && memcmp(slot.value, values, size * sizeof(GLfloat)) == 0) {
+        return false;
+    }
+    memcpy(slot.value, values, size * sizeof(GLfloat));
+    slot.valid = true;
+    return true;
+}
+
+void GlState::uniform1i(GLint location, GLint value) {
+    // Compared bit for bit, so the int can share the float storage
+    GLfloat bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if (!count(CALL_UNIFORM, uniformChanged(location, &bits, 1))) return;
+    glUniform1i(location, value);
+}
+
+void GlState::uniform1f(GLint location, GLfloat value) {
+    if (!count(CALL_UNIFORM, uniformChanged(location, &value, 1))) return;
+    glUniform1f(location, value);
+}
+
+void GlState::uniform2f(GLint location, GLfloat x, GLfloat y) {
+    const GLfloat values[2] = {x, y};
+    if (!count(CALL_UNIFORM, uniformChanged(location, values, 2))) return;
+    glUniform2f(location, x, y);
+}
+
+void GlState::uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+    const GLfloat values[4] = {x, y, z, w};
+    if (!count(CALL_UNIFORM, uniformChanged(location, values, 4))) return;
+    glUniform4f(location, x, y, z, w);
+}
+
+void GlState::uniformMatrix4(GLint location, const GLfloat* matrix) {
+    if (!count(CALL_UNIFORM, uniformChanged(location, matrix, 16))) return;
+    glUniformMatrix4fv(location, 1, GL_FALSE, matrix);
+}
+
+std::string GlState::report() const {
+    std::string result;
+    char line[96];
+    uint64_t totalIssued = 0;
+    uint64_t totalElided = 0;
+    for (int call = 0; call < CALL_COUNT; call++) {
+        uint64_t total = issued[call] + elided[call];
+        totalIssued += issued[call];
+        totalElided += elided[call];
+        if (total == 0) continue;
+        snprintf(line, sizeof(line), "%-14s issued %10llu  elided %10llu (%.1f%%)\n", kCallNames[call],
+                 (unsigned long long)issued[call], (unsigned long long)elided[call],
+                 100.0 * elided[call] / total);
+        result += line;
+    }
+    uint64_t total = totalIssued + totalElided;
+    snprintf(line, sizeof(line), "%-14s issued %10llu  elided %10llu (%.1f%%)\n", "total",
+             (unsigned long long)totalIssued, (unsigned long long)totalElided,
+             total ? 100.0 * totalElided / total : 0.0);
+    result += line;
+    return result;
+}
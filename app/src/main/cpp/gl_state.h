@@ -0,0 +1,122 @@
+#ifndef TOUCHGAME_GL_STATE_H
+#define TOUCHGAME_GL_STATE_H
+
+#include <GLES2/gl2.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Shadow copy of the GLES2 state the renderer touches every frame.
+//
+// Draw code states what it needs (program, array buffer, enabled vertex
+// attributes and their pointers, blending, texture, uniform values) and the
+// cache only forwards calls that change something. Uniform values are
+// remembered per program, so constants like the projection or an unchanged
+// background color cost nothing after the first frame.
+//
+// The shadow is only valid while nothing else changes that state: call
+// invalidate() after making a new context current or after setup code that
+// binds directly. Deleting a bound program/buffer/texture also requires
+// invalidate().
+class GlState {
+public:
+    // Per entry point kind, for the issued/elided counters
+    enum Call {
+        CALL_USE_PROGRAM = 0,
+        CALL_BIND_BUFFER,
+        CALL_ATTRIB_ARRAY,     // glEnable/DisableVertexAttribArray
+        CALL_ATTRIB_POINTER,
+        CALL_BLEND,            // glEnable/Disable(GL_BLEND)
+        CALL_BLEND_FUNC,
+        CALL_ACTIVE_TEXTURE,
+        CALL_BIND_TEXTURE,
+        CALL_UNIFORM,
+        CALL_COUNT
+    };
+
+    static const GLuint MAX_ATTRIBS = 16;
+
+    GlState() : attribLimit(0) { invalidate(); resetCounters(); }
+
+    // Forget everything; the next request of each kind is always issued
+    void invalidate();
+
+    void useProgram(GLuint program);
+    void bindArrayBuffer(GLuint buffer);
+    // Exactly the attributes in the bit mask end up enabled; counted as one
+    // elided call when none change. Indices at or above the device's
+    // GL_MAX_VERTEX_ATTRIBS (queried on first use) are never touched.
+    void setAttribArrays(uint32_t mask);
+    // Mask bit for an attribute location; 0 for -1 (optimized out) and for
+    // locations the cache does not track
+    static uint32_t attribBit(GLint location) {
+        return location >= 0 && location < static_cast<GLint>(MAX_ATTRIBS) ? 1u << location : 0;
+    }
+    // Offset into the currently bound array buffer
+    void attribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+                       size_t offset);
+    void setBlend(bool enabled);
+    void blendFunc(GLenum source, GLenum destination);
+    void bindTexture2D(GLuint unit, GLuint texture);
+
+    // Uniforms of the current program
+    void uniform1i(GLint location, GLint value);
+    void uniform1f(GLint location, GLfloat value);
+    void uniform2f(GLint location, GLfloat x, GLfloat y);
+    void uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+    void uniformMatrix4(GLint location, const GLfloat* matrix);
+
+    GLuint getArrayBuffer() const { return arrayBuffer; }
+
+    uint64_t getIssued(Call call) const { return issued[call]; }
+    uint64_t getElided(Call call) const { return elided[call]; }
+    void resetCounters();
+    // One line per call kind: issued, elided and the elided share
+    std::string report() const;
+
+private:
+    struct AttribPointer {
+        GLuint buffer;
+        GLint size;
+        GLenum type;
+        GLboolean normalized;
+        GLsizei stride;
+        size_t offset;
+        bool valid;
+    };
+
+    // Last value per uniform location: up to 16 floats, or an int in value[0]
+    struct UniformSlot {
+        GLfloat value[16];
+        bool valid;
+    };
+
+    // Records the value; false if the current program already has it
+    bool uniformChanged(GLint location, const GLfloat* values, int size);
+    bool count(Call call, bool changed) {
+        (changed ? issued : elided)[call]++;
+        return changed;
+    }
+
+    static const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+    GLuint program;
+    GLuint arrayBuffer;
+    uint32_t enabledAttribs;
+    bool attribsKnown;
+    GLuint attribLimit;         // min(GL_MAX_VERTEX_ATTRIBS, MAX_ATTRIBS); 0 until queried
+    AttribPointer pointers[MAX_ATTRIBS];
+    int blend;                  // -1 unknown, 0 off, 1 on
+    GLenum blendSource;
+    GLenum blendDestination;
+    GLuint activeUnit;
+    GLuint texture2D[8];        // per texture unit
+    std::unordered_map<GLuint, std::vector<UniformSlot>> uniforms;
+    std::vector<UniformSlot>* programUniforms; // uniforms[program]
+
+    uint64_t issued[CALL_COUNT];
+    uint64_t elided[CALL_COUNT];
+};
+
+#endif // TOUCHGAME_GL_STATE_H
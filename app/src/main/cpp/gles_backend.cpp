@@ -0,0 +1,972 @@
+#include "gles_backend.h"
+#include "game.h"
+#include "hud.h"
+#include "packed_entities.h"
+#include "particles.h"
+#include "stream_buffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#ifdef __ANDROID__
+#include <android/native_window.h>
+#endif
+
+static const char* vertexShaderSource = R"(
+    attribute vec2 position;
+    uniform mat4 mvp;
+    void main() {
+        gl_Position = mvp * vec4(position, 0.0, 1.0);
+    }
+)";
+
+static const char* fragmentShaderSource = R"(
+    precision mediump float;
+    uniform vec4 color;
+    void main() {
+        gl_FragColor = color;
+    }
+)";
+
+// Sphere impostor: one quad per ball, six vertices that all carry the
+// ball, so a whole frame of balls is a single draw
+static const char* impostorVertexShaderSource = R"(
+    attribute vec2 corner;     // quad corner, -1..1
+    attribute vec4 shape;      // x, y, radius, flash timer
+    attribute vec3 color;
+    uniform mat4 mvp;
+    uniform vec2 screenSize;
+    varying vec2 vLocal;       // fragment position in ball radii from the centre
+    varying vec2 vHighlight;   // highlight centre, ball radii
+    varying vec3 vColor;
+    varying float vFlash;      // brightness added by the touch flash
+    varying float vPixel;      // one screen pixel in ball radii
+    void main() {
+        float radius = shape.z;
+        // A pixel of margin so the anti-aliased edge is not clipped
+        vLocal = corner * (1.0 + 1.0 / radius);
+        vPixel = 1.0 / radius;
+
+        // Highlight offset towards the light at the screen centre
+        vec2 toLight = screenSize * 0.5 - shape.xy;
+        float toLightDist = length(toLight);
+        vHighlight = toLightDist > 0.01 ? toLight / toLightDist * 0.3 : vec2(0.0, -0.3);
+
+        vColor = color;
+        vFlash = shape.w > 0.0 ? shape.w / 0.15 * 0.8 : 0.0;
+        gl_Position = mvp * vec4(shape.xy + vLocal * radius, 0.0, 1.0);
+    }
+)";
+
+// Same piecewise brightness, rim and flash as renderCircle, evaluated at
+// the fragment's distance from the centre (the sine of the sphere normal's
+// tilt) instead of once per ring
+static const char* impostorFragmentShaderSource = R"(
+    precision mediump float;
+    varying vec2 vLocal;
+    varying vec2 vHighlight;
+    varying vec3 vColor;
+    varying float vFlash;
+    varying float vPixel;
+
+    float sphereBrightness(float normalizedRadius) {
+        float brightness;
+        if (normalizedRadius < 1.0 / 24.0) {
+            brightness = 2.4;
+        } else if (normalizedRadius < 0.15) {
+            float t = normalizedRadius / 0.15;
+            brightness = 2.4 - t * 0.6;
+        } else if (normalizedRadius < 0.35) {
+            float t = (normalizedRadius - 0.15) / 0.2;
+            brightness = 1.8 - t * 0.4;
+        } else if (normalizedRadius < 0.6) {
+            float t = (normalizedRadius - 0.35) / 0.25;
+            brightness = 1.4 - t * t * 0.35;
+        } else if (normalizedRadius < 0.85) {
+            float t = (normalizedRadius - 0.6) / 0.25;
+            brightness = 1.05 - t * t * 0.35;
+        } else {
+            float t = min((normalizedRadius - 0.85) / 0.15, 1.0);
+            brightness = 0.7 - t * t * t * 0.35;
+            if (normalizedRadius > 0.9) {
+                float rimStrength = min((normalizedRadius - 0.9) / 0.1, 1.0);
+                brightness += rimStrength * rimStrength * 0.25;
+            }
+        }
+        return brightness * 0.88 + 0.12;
+    }
+
+    void main() {
+        float normalizedRadius = length(vLocal);
+        vec3 color = min(vColor * (sphereBrightness(normalizedRadius) + vFlash), vec3(1.0));
+
+        // White glossy highlight at 60% over the shading; both edges are
+        // anti-aliased over one pixel
+        float highlightEdge = 0.22 - length(vLocal - vHighlight);
+        float highlight = clamp(highlightEdge / vPixel + 0.5, 0.0, 1.0);
+        color = mix(color, vec3(1.0), 0.6 * highlight);
+
+        float coverage = clamp((1.0 - normalizedRadius) / vPixel + 0.5, 0.0, 1.0);
+        gl_FragColor = vec4(color, coverage);
+    }
+)";
+
+// GPU particles: the static template holds particle indices and quad
+// corners; uniforms carry one ParticleSpawn. Every random draw of
+// Game::createExplosion comes from a hash of (particle index, seed), and
+// motion under constant gravity has a closed form, so the position and fade
+// follow from the age alone. Faded particles collapse to zero area.
+static const char* particleVertexShaderSource = R"(
+    attribute float particleIndex;
+    attribute vec2 corner;      // -1 or 1
+    uniform mat4 mvp;
+    uniform vec4 spawnOrigin;   // x, y, spawn time, seed
+    uniform vec4 spawnColor;    // r, g, b, jitter
+    uniform vec4 spawnShape;    // size min/max, speed min/max
+    uniform vec4 spawnMotion;   // upward bias, gravity, lifetime min/max
+    uniform float indexBase;    // first particle of this draw
+    uniform float time;
+    varying vec4 vColor;
+
+    // Four uniform values in [0, 1) from two floats (Hoskins' hash without
+    // sine: stable across GPUs, needs only highp)
+    vec4 hash42(vec2 p) {
+        vec4 p4 = fract(p.xyxy * vec4(0.1031, 0.1030, 0.0973, 0.1099));
+        p4 += dot(p4, p4.wzxy + 33.33);
+        return fract((p4.xxyz + p4.yzzw) * p4.zywx);
+    }
+
+    void main() {
+        float index = particleIndex + indexBase;
+        vec4 draw = hash42(vec2(index, spawnOrigin.w));
+        vec4 jitter = hash42(vec2(spawnOrigin.w, index));
+
+        float age = time - spawnOrigin.z;
+        float lifetime = mix(spawnMotion.z, spawnMotion.w, draw.w);
+        float angle = draw.x * 6.2831853;
+        float speed = mix(spawnShape.z, spawnShape.w, draw.y);
+        vec2 velocity = vec2(cos(angle), sin(angle)) * speed - vec2(0.0, spawnMotion.x);
+        vec2 position = spawnOrigin.xy + velocity * age + vec2(0.0, 0.5 * spawnMotion.y * age * age);
+        float size = age < lifetime ? mix(spawnShape.x, spawnShape.y, draw.z) : 0.0;
+
+        vColor = vec4(min(spawnColor.rgb + (jitter.xyz - 0.5) * spawnColor.w, vec3(1.0)),
+                      1.0 - age / lifetime);
+        gl_Position = mvp * vec4(position + corner * (size * 0.5), 0.0, 1.0);
+    }
+)";
+
+static const char* particleFragmentShaderSource = R"(
+    precision mediump float;
+    varying vec4 vColor;
+    void main() {
+        gl_FragColor = vColor;
+    }
+)";
+
+// Packed particles: the PackedParticle array is the vertex buffer, one
+// point sprite per particle (squares, like the CPU path's quads). Fixed-
+// point positions arrive normalized: +/-1 is +/-2 screens.
+static const char* packedParticleVertexShaderSource = R"(
+    attribute vec2 position;
+    attribute vec4 color;
+    attribute float size;       // half pixels
+    uniform mat4 mvp;
+    uniform vec2 screenSize;
+    varying vec4 vColor;
+    void main() {
+        vColor = color;
+        gl_PointSize = size * 0.5;
+        gl_Position = mvp * vec4(position * screenSize * (32767.0 / 16384.0), 0.0, 1.0);
+    }
+)";
+
+// Particle template vertex: index and corner, 4 bytes
+struct ParticleTemplateVertex {
+    uint16_t index;
+    int8_t cornerX;
+    int8_t cornerY;
+};
+
+static const char* gradientVertexShaderSource = R"(
+    attribute vec2 position;
+    varying vec2 vPosition;
+    void main() {
+        gl_Position = vec4(position, 0.0, 1.0);
+        vPosition = position;
+    }
+)";
+
+static const char* gradientFragmentShaderSource = R"(
+    precision mediump float;
+    varying vec2 vPosition;
+    uniform vec4 color1;
+    uniform vec4 color2;
+    void main() {
+        float gradient = (vPosition.y + 1.0) * 0.5;
+        gl_FragColor = mix(color1, color2, gradient);
+    }
+)";
+
+static const char* hudVertexShaderSource = R"(
+    attribute vec2 position;
+    attribute vec2 texCoord;
+    varying vec2 vTexCoord;
+    void main() {
+        gl_Position = vec4(position, 0.0, 1.0);
+        vTexCoord = texCoord;
+    }
+)";
+
+static const char* hudFragmentShaderSource = R"(
+    precision mediump float;
+    uniform sampler2D atlas;
+    uniform vec4 fillColor;
+    uniform vec4 outlineColor;
+    uniform float smoothing;
+    varying vec2 vTexCoord;
+    void main() {
+        float distance = texture2D(atlas, vTexCoord).a;
+        float fill = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+        float outline = smoothstep(0.38 - smoothing, 0.38 + smoothing, distance);
+        vec4 color = mix(outlineColor, fillColor, fill);
+        gl_FragColor = vec4(color.rgb, color.a * outline);
+    }
+)";
+
+static GLuint createProgram(const char* vertexSource, const char* fragmentSource) {
+    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &vertexSource, nullptr);
+    glCompileShader(vertexShader);
+
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fragmentSource, nullptr);
+    glCompileShader(fragmentShader);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return program;
+}
+
+GlesBackend::GlesBackend() : display(EGL_NO_DISPLAY), surface(EGL_NO_SURFACE),
+                             context(EGL_NO_CONTEXT), config(nullptr), preloaded(false),
+                             surfaceWidth(0), surfaceHeight(0),
+                             eglGetNextFrameIdANDROIDFn(nullptr),
+                             eglGetFrameTimestampsANDROIDFn(nullptr),
+                             shaderProgram(0), impostorProgram(0), ballStyle(BALL_STYLE_MESH),
+                             particleProgram(0), particleTemplateVbo(0), packedParticleProgram(0),
+                             gradientShaderProgram(0), gradientVbo(0),
+                             hudProgram(0), hudTexture(0), hudVbo(0), hudVersion(0),
+                             hudVertexCount(0) {
+}
+
+GlesBackend::~GlesBackend() {
+    if (display == EGL_NO_DISPLAY) return;
+
+    if (context != EGL_NO_CONTEXT &&
+        eglMakeCurrent(display, surface, surface, context) == EGL_TRUE) {
+        if (shaderProgram) {
+            glDeleteProgram(shaderProgram);
+        }
+        stream.destroy();
+        if (impostorProgram) {
+            glDeleteProgram(impostorProgram);
+        }
+        if (particleProgram) {
+            glDeleteProgram(particleProgram);
+        }
+        if (particleTemplateVbo) {
+            glDeleteBuffers(1, &particleTemplateVbo);
+        }
+        if (packedParticleProgram) {
+            glDeleteProgram(packedParticleProgram);
+        }
+        if (gradientShaderProgram) {
+            glDeleteProgram(gradientShaderProgram);
+        }
+        if (gradientVbo) {
+            glDeleteBuffers(1, &gradientVbo);
+        }
+        if (hudProgram) {
+            glDeleteProgram(hudProgram);
+        }
+        if (hudTexture) {
+            glDeleteTextures(1, &hudTexture);
+        }
+        if (hudVbo) {
+            glDeleteBuffers(1, &hudVbo);
+        }
+    }
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context != EGL_NO_CONTEXT) {
+        eglDestroyContext(display, context);
+    }
+    if (surface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, surface);
+    }
+    eglTerminate(display);
+}
+
+bool GlesBackend::init(void* nativeWindow, int width, int height, const std::string& cacheDir) {
+    if (preloaded) {
+        // Swap preload()'s placeholder pbuffer for the real surface
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroySurface(display, surface);
+        surface = EGL_NO_SURFACE;
+        if (!createSurface(nativeWindow, width, height) || !makeCurrent()) {
+            return false;
+        }
+    } else {
+        if (!initContext(nativeWindow ? EGL_WINDOW_BIT : EGL_PBUFFER_BIT) ||
+            !createSurface(nativeWindow, width, height) || !makeCurrent()) {
+            return false;
+        }
+        setupShaders();
+        setupHud(cacheDir);
+    }
+    // Setup bound objects directly, and a preloaded context may have
+    // changed threads; start the shadow from scratch
+    state.invalidate();
+
+    EGLint queriedWidth, queriedHeight;
+    eglQuerySurface(display, surface, EGL_WIDTH, &queriedWidth);
+    eglQuerySurface(display, surface, EGL_HEIGHT, &queriedHeight);
+    surfaceWidth = queriedWidth;
+    surfaceHeight = queriedHeight;
+    glViewport(0, 0, surfaceWidth, surfaceHeight);
+
+    if (nativeWindow != nullptr) {
+        setupFrameTimestamps();
+    }
+    return true;
+}
+
+bool GlesBackend::preload(const std::string& cacheDir) {
+#ifdef __ANDROID__
+    // The context outlives the 1x1 pbuffer, so its config must also suit
+    // the window surface init() creates later
+    EGLint surfaceType = EGL_WINDOW_BIT | EGL_PBUFFER_BIT;
+#else
+    EGLint surfaceType = EGL_PBUFFER_BIT;
+#endif
+    if (!initContext(surfaceType) || !createSurface(nullptr, 1, 1) || !makeCurrent()) {
+        return false;
+    }
+
+    setupShaders();
+    setupHud(cacheDir);
+    // Drivers may defer compiling and uploading until first use; make them
+    // finish here, off the render thread
+    glFinish();
+
+    // Release the context so the render thread can take it
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglReleaseThread();
+    preloaded = true;
+    return true;
+}
+
+bool GlesBackend::initContext(EGLint surfaceType) {
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+#ifndef __ANDROID__
+    // Host benchmarks run without a display server; Mesa renders surfaceless
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (surfaceType == EGL_PBUFFER_BIT && clientExtensions != nullptr &&
+        strstr(clientExtensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+    }
+#endif
+    if (display == EGL_NO_DISPLAY || eglInitialize(display, nullptr, nullptr) == EGL_FALSE) {
+        return false;
+    }
+
+    const EGLint attribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_SURFACE_TYPE, surfaceType,
+        EGL_BLUE_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_RED_SIZE, 8,
+        EGL_NONE
+    };
+
+    EGLint numConfigs;
+    if (eglChooseConfig(display, attribs, &config, 1, &numConfigs) == EGL_FALSE || numConfigs < 1) {
+        return false;
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    return context != EGL_NO_CONTEXT;
+}
+
+bool GlesBackend::createSurface(void* nativeWindow, int width, int height) {
+    if (nativeWindow != nullptr) {
+#ifdef __ANDROID__
+        ANativeWindow* window = static_cast<ANativeWindow*>(nativeWindow);
+        EGLint format;
+        eglGetConfigAttrib(display, config, EGL_NATIVE_VISUAL_ID, &format);
+        ANativeWindow_setBuffersGeometry(window, 0, 0, format);
+        surface = eglCreateWindowSurface(display, config, window, nullptr);
+#else
+        return false;
+#endif
+    } else {
+        const EGLint pbufferAttribs[] = {
+            EGL_WIDTH, width,
+            EGL_HEIGHT, height,
+            EGL_NONE
+        };
+        surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+    }
+    return surface != EGL_NO_SURFACE;
+}
+
+// Enables EGL_ANDROID_get_frame_timestamps on the window surface so we can
+// learn when each frame actually reached the display
+bool GlesBackend::setupFrameTimestamps() {
+    eglGetNextFrameIdANDROIDFn = nullptr;
+    eglGetFrameTimestampsANDROIDFn = nullptr;
+
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (extensions == nullptr || strstr(extensions, "EGL_ANDROID_get_frame_timestamps") == nullptr) {
+        return false;
+    }
+
+    auto isSupported = reinterpret_cast<PFNEGLGETFRAMETIMESTAMPSUPPORTEDANDROIDPROC>(
+        eglGetProcAddress("eglGetFrameTimestampSupportedANDROID"));
+    auto getNextFrameId = reinterpret_cast<PFNEGLGETNEXTFRAMEIDANDROIDPROC>(
+        eglGetProcAddress("eglGetNextFrameIdANDROID"));
+    auto getFrameTimestamps = reinterpret_cast<PFNEGLGETFRAMETIMESTAMPSANDROIDPROC>(
+        eglGetProcAddress("eglGetFrameTimestampsANDROID"));
+    if (!isSupported || !getNextFrameId || !getFrameTimestamps) {
+        return false;
+    }
+
+    if (eglSurfaceAttrib(display, surface, EGL_TIMESTAMPS_ANDROID, EGL_TRUE) == EGL_FALSE ||
+        !isSupported(display, surface, EGL_DISPLAY_PRESENT_TIME_ANDROID)) {
+        return false;
+    }
+
+    eglGetNextFrameIdANDROIDFn = getNextFrameId;
+    eglGetFrameTimestampsANDROIDFn = getFrameTimestamps;
+    return true;
+}
+
+void GlesBackend::setupShaders() {
+    shaderProgram = createProgram(vertexShaderSource, fragmentShaderSource);
+    positionLoc = glGetAttribLocation(shaderProgram, "position");
+    colorLoc = glGetUniformLocation(shaderProgram, "color");
+    mvpLoc = glGetUniformLocation(shaderProgram, "mvp");
+    stream.create();
+
+    impostorProgram = createProgram(impostorVertexShaderSource, impostorFragmentShaderSource);
+    impostorCornerLoc = glGetAttribLocation(impostorProgram, "corner");
+    impostorShapeLoc = glGetAttribLocation(impostorProgram, "shape");
+    impostorColorLoc = glGetAttribLocation(impostorProgram, "color");
+    impostorMvpLoc = glGetUniformLocation(impostorProgram, "mvp");
+    impostorScreenSizeLoc = glGetUniformLocation(impostorProgram, "screenSize");
+
+    particleProgram = createProgram(particleVertexShaderSource, particleFragmentShaderSource);
+    particleIndexLoc = glGetAttribLocation(particleProgram, "particleIndex");
+    particleCornerLoc = glGetAttribLocation(particleProgram, "corner");
+    particleMvpLoc = glGetUniformLocation(particleProgram, "mvp");
+    particleOriginLoc = glGetUniformLocation(particleProgram, "spawnOrigin");
+    particleColorLoc = glGetUniformLocation(particleProgram, "spawnColor");
+    particleShapeLoc = glGetUniformLocation(particleProgram, "spawnShape");
+    particleMotionLoc = glGetUniformLocation(particleProgram, "spawnMotion");
+    particleIndexBaseLoc = glGetUniformLocation(particleProgram, "indexBase");
+    particleTimeLoc = glGetUniformLocation(particleProgram, "time");
+
+    packedParticleProgram = createProgram(packedParticleVertexShaderSource, particleFragmentShaderSource);
+    packedPositionLoc = glGetAttribLocation(packedParticleProgram, "position");
+    packedColorLoc = glGetAttribLocation(packedParticleProgram, "color");
+    packedSizeLoc = glGetAttribLocation(packedParticleProgram, "size");
+    packedMvpLoc = glGetUniformLocation(packedParticleProgram, "mvp");
+    packedScreenSizeLoc = glGetUniformLocation(packedParticleProgram, "screenSize");
+
+    // Two triangles per particle, enough for the largest draw
+    std::vector<ParticleTemplateVertex> particleTemplate(PARTICLES_PER_DRAW * 6);
+    static const int8_t corners[6][2] = {{-1, -1}, {1, -1}, {-1, 1}, {-1, 1}, {1, -1}, {1, 1}};
+    for (int i = 0; i < PARTICLES_PER_DRAW; i++) {
+        for (int c = 0; c < 6; c++) {
+            ParticleTemplateVertex& vertex = particleTemplate[i * 6 + c];
+            vertex.index = static_cast<uint16_t>(i);
+            vertex.cornerX = corners[c][0];
+            vertex.cornerY = corners[c][1];
+        }
+    }
+    glGenBuffers(1, &particleTemplateVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, particleTemplateVbo);
+    glBufferData(GL_ARRAY_BUFFER, particleTemplate.size() * sizeof(ParticleTemplateVertex),
+                 particleTemplate.data(), GL_STATIC_DRAW);
+
+    gradientShaderProgram = createProgram(gradientVertexShaderSource, gradientFragmentShaderSource);
+    gradientPositionLoc = glGetAttribLocation(gradientShaderProgram, "position");
+    gradientColor1Loc = glGetUniformLocation(gradientShaderProgram, "color1");
+    gradientColor2Loc = glGetUniformLocation(gradientShaderProgram, "color2");
+
+    // Full screen quad vertices in normalized device coordinates
+    const float quadVertices[] = {
+        -1.0f, -1.0f,  // Bottom left
+         1.0f, -1.0f,  // Bottom right
+        -1.0f,  1.0f,  // Top left
+         1.0f,  1.0f   // Top right
+    };
+    glGenBuffers(1, &gradientVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, gradientVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+}
+
+void GlesBackend::setupHud(const std::string& cacheDir) {
+    if (!font.load(cacheDir)) {
+        return;
+    }
+
+    hudProgram = createProgram(hudVertexShaderSource, hudFragmentShaderSource);
+    hudPositionLoc = glGetAttribLocation(hudProgram, "position");
+    hudTexCoordLoc = glGetAttribLocation(hudProgram, "texCoord");
+    hudAtlasLoc = glGetUniformLocation(hudProgram, "atlas");
+    hudFillColorLoc = glGetUniformLocation(hudProgram, "fillColor");
+    hudOutlineColorLoc = glGetUniformLocation(hudProgram, "outlineColor");
+    hudSmoothingLoc = glGetUniformLocation(hudProgram, "smoothing");
+
+    glGenTextures(1, &hudTexture);
+    glBindTexture(GL_TEXTURE_2D, hudTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, font.getWidth(), font.getHeight(), 0,
+                 GL_ALPHA, GL_UNSIGNED_BYTE, font.getPixels().data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenBuffers(1, &hudVbo);
+    hudVersion = 0;
+    hudVertexCount = 0;
+}
+
+bool GlesBackend::makeCurrent() {
+    return eglMakeCurrent(display, surface, surface, context) == EGL_TRUE;
+}
+
+void GlesBackend::drawFrame(const FrameData& frame) {
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Render gradient background. The quad never changes and the colors only
+    // between rounds, so after the first frame this is usually just the draw.
+    state.useProgram(gradientShaderProgram);
+    state.bindArrayBuffer(gradientVbo);
+    state.setAttribArrays(GlState::attribBit(gradientPositionLoc));
+    state.attribPointer(gradientPositionLoc, 2, GL_FLOAT, GL_FALSE, 0, 0);
+
+    state.uniform4f(gradientColor1Loc, frame.bgColor1[0], frame.bgColor1[1], frame.bgColor1[2], 1.0f);
+    state.uniform4f(gradientColor2Loc, frame.bgColor2[0], frame.bgColor2[1], frame.bgColor2[2], 1.0f);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    // Orthographic projection from screen pixels, origin at the top left.
+    // Circles and particles share it so both follow the simulation's axes.
+    float left = 0.0f;
+    float right = static_cast<float>(frame.screenWidth);
+    float bottom = static_cast<float>(frame.screenHeight);
+    float top = 0.0f;
+    float near = -1.0f;
+    float far = 1.0f;
+
+    float ortho[16] = {
+        2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+        0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
+        0.0f, 0.0f, -2.0f / (far - near), 0.0f,
+        -(right + left) / (right - left), -(top + bottom) / (top - bottom), -(far + near) / (far - near), 1.0f
+    };
+
+    // Circle and particle vertices are streamed; draws address them by
+    // first vertex so the attribute pointer stays at offset 0
+    stream.beginFrame(state);
+    state.useProgram(shaderProgram);
+    state.uniformMatrix4(mvpLoc, ortho);
+    state.bindArrayBuffer(stream.getBuffer());
+    state.setAttribArrays(GlState::attribBit(positionLoc));
+    state.attribPointer(positionLoc, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    state.setBlend(false);
+
+    if (ballStyle == BALL_STYLE_IMPOSTOR) {
+        if (!frame.circles->empty()) {
+            renderImpostors(frame, ortho);
+        }
+    } else {
+        for (const auto& circle : *frame.circles) {
+            renderCircle(frame, circle);
+        }
+    }
+
+    if (!frame.particles->empty()) {
+        renderParticles(*frame.particles);
+    }
+    if (frame.packedParticles != nullptr && !frame.packedParticles->empty()) {
+        renderPackedParticles(*frame.packedParticles, frame, ortho);
+    }
+    if (frame.particleSpawns != nullptr && frame.particleSpawns->size() > 0) {
+        renderParticleSpawns(*frame.particleSpawns, frame.particleTime, ortho);
+    }
+
+    if (frame.hud != nullptr) {
+        renderHud(*frame.hud);
+    }
+}
+
+void GlesBackend::renderCircle(const FrameData& frame, const Circle& circle) {
+    // Draw 3D ball with realistic lighting and shading
+    const int segments = 48;
+    const int rings = 24; // More rings for ultra-smooth gradient
+
+    // Light position (center of screen)
+    float screenCenterX = frame.screenWidth / 2.0f;
+    float screenCenterY = frame.screenHeight / 2.0f;
+
+    // Calculate direction from circle to light
+    float toLightX = screenCenterX - circle.x;
+    float toLightY = screenCenterY - circle.y;
+    float toLightDist = sqrtf(toLightX * toLightX + toLightY * toLightY);
+
+    // Normalize and scale to create highlight offset
+    float lightOffsetX, lightOffsetY;
+    if (toLightDist > 0.01f) {
+        float normalizedX = toLightX / toLightDist;
+        float normalizedY = toLightY / toLightDist;
+        lightOffsetX = normalizedX * circle.radius * 0.3f;
+        lightOffsetY = normalizedY * circle.radius * 0.3f;
+    } else {
+        // Circle is at screen center, default to top offset
+        lightOffsetX = 0.0f;
+        lightOffsetY = -circle.radius * 0.3f;
+    }
+
+    // All rings and the highlight fan go up in one upload
+    const int ringVertexCount = (segments + 1) * 2;
+    const int highlightSegments = 28;
+    float vertices[rings * ringVertexCount * 2 + (highlightSegments + 2) * 2];
+    float ringColors[rings][3];
+    int vertexIndex = 0;
+
+    // Draw from center to outer edge with spherical gradient
+    for (int ring = 0; ring < rings; ring++) {
+        float innerRadius = (ring / (float)rings) * circle.radius;
+        float outerRadius = ((ring + 1) / (float)rings) * circle.radius;
+
+        for (int i = 0; i <= segments; i++) {
+            float angle = 2.0f * M_PI * i / segments;
+            float cosAngle = cos(angle);
+            float sinAngle = sin(angle);
+
+            // Inner vertex
+            vertices[vertexIndex++] = circle.x + innerRadius * cosAngle;
+            vertices[vertexIndex++] = circle.y + innerRadius * sinAngle;
+
+            // Outer vertex
+            vertices[vertexIndex++] = circle.x + outerRadius * cosAngle;
+            vertices[vertexIndex++] = circle.y + outerRadius * sinAngle;
+        }
+
+        // Simulate spherical lighting using the ring's distance from the centre
+        float ringCenterRadius = (innerRadius + outerRadius) / 2.0f;
+        float normalizedRadius = ringCenterRadius / circle.radius;
+
+        // Enhanced brightness calculation with smoother falloff
+        float brightness;
+        if (ring == 0) {
+            // Brightest specular highlight at center
+            brightness = 2.4f;
+        } else if (normalizedRadius < 0.15f) {
+            // Very bright core area with smooth transition
+            float t = normalizedRadius / 0.15f;
+            brightness = 2.4f - t * 0.6f; // 2.4 to 1.8
+        } else if (normalizedRadius < 0.35f) {
+            // Bright highlight area
+            float t = (normalizedRadius - 0.15f) / 0.2f;
+            brightness = 1.8f - t * 0.4f; // 1.8 to 1.4
+        } else if (normalizedRadius < 0.6f) {
+            // Mid-tones with gradual falloff
+            float t = (normalizedRadius - 0.35f) / 0.25f;
+            t = t * t; // Quadratic for smoother transition
+            brightness = 1.4f - t * 0.35f; // 1.4 to 1.05
+        } else if (normalizedRadius < 0.85f) {
+            // Shadow area
+            float t = (normalizedRadius - 0.6f) / 0.25f;
+            t = t * t; // Quadratic for smoother transition
+            brightness = 1.05f - t * 0.35f; // 1.05 to 0.7
+        } else {
+            // Dark edge with smooth ambient occlusion
+            float t = (normalizedRadius - 0.85f) / 0.15f;
+            t = t * t * t; // Cubic for very smooth edge
+            brightness = 0.7f - t * 0.35f; // 0.7 to 0.35
+
+            // Enhanced rim lighting effect
+            if (normalizedRadius > 0.9f) {
+                float rimStrength = (normalizedRadius - 0.9f) / 0.1f;
+                rimStrength = rimStrength * rimStrength; // Quadratic for smooth rim
+                brightness += rimStrength * 0.25f; // Stronger rim light
+            }
+        }
+
+        // Add ambient light so it's never completely black
+        brightness = brightness * 0.88f + 0.12f;
+
+        // Add flash effect when circle is touched
+        if (circle.flashTimer > 0.0f) {
+            float flashStrength = circle.flashTimer / 0.15f; // 0.15 second flash duration
+            brightness += flashStrength * 0.8f; // Bright flash
+        }
+
+        // Apply brightness to color
+        float r = circle.colorR * brightness;
+        float g = circle.colorG * brightness;
+        float b = circle.colorB * brightness;
+
+        // Clamp values
+        r = r > 1.0f ? 1.0f : r;
+        g = g > 1.0f ? 1.0f : g;
+        b = b > 1.0f ? 1.0f : b;
+
+        ringColors[ring][0] = r;
+        ringColors[ring][1] = g;
+        ringColors[ring][2] = b;
+    }
+
+    // Add glossy highlight spot with smoother edges
+    float highlightRadius = circle.radius * 0.22f;
+    float highlightX = circle.x + lightOffsetX;
+    float highlightY = circle.y + lightOffsetY;
+
+    vertices[vertexIndex++] = highlightX;
+    vertices[vertexIndex++] = highlightY;
+    for (int i = 0; i <= highlightSegments; i++) {
+        float angle = 2.0f * M_PI * i / highlightSegments;
+        vertices[vertexIndex++] = highlightX + highlightRadius * cos(angle);
+        vertices[vertexIndex++] = highlightY + highlightRadius * sin(angle);
+    }
+
+    GLint first = static_cast<GLint>(stream.upload(state, vertices, sizeof(vertices)) / (2 * sizeof(float)));
+
+    for (int ring = 0; ring < rings; ring++) {
+        state.uniform4f(colorLoc, ringColors[ring][0], ringColors[ring][1], ringColors[ring][2], 1.0f);
+        glDrawArrays(GL_TRIANGLE_STRIP, first + ring * ringVertexCount, ringVertexCount);
+    }
+
+    // White glossy highlight with some transparency
+    state.uniform4f(colorLoc, 1.0f, 1.0f, 1.0f, 0.6f);
+    state.setBlend(true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLE_FAN, first + rings * ringVertexCount, highlightSegments + 2);
+    state.setBlend(false);
+}
+
+void GlesBackend::renderImpostors(const FrameData& frame, const float* projection) {
+    // Per vertex: corner, shape (x, y, radius, flash), color
+    const int floatsPerVertex = 9;
+    static const float corners[6][2] = {
+        {-1.0f, -1.0f}, {1.0f, -1.0f}, {-1.0f, 1.0f},
+        {-1.0f, 1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}
+    };
+
+    impostorVertices.resize(frame.circles->size() * 6 * floatsPerVertex);
+    float* vertex = impostorVertices.data();
+    for (const auto& circle : *frame.circles) {
+        for (const auto& corner : corners) {
+            *vertex++ = corner[0];
+            *vertex++ = corner[1];
+            *vertex++ = circle.x;
+            *vertex++ = circle.y;
+            *vertex++ = circle.radius;
+            *vertex++ = circle.flashTimer;
+            *vertex++ = circle.colorR;
+            *vertex++ = circle.colorG;
+            *vertex++ = circle.colorB;
+        }
+    }
+
+    size_t offset = stream.upload(state, impostorVertices.data(), impostorVertices.size() * sizeof(float));
+    const GLsizei stride = floatsPerVertex * sizeof(float);
+
+    state.useProgram(impostorProgram);
+    state.uniformMatrix4(impostorMvpLoc, projection);
+    state.uniform2f(impostorScreenSizeLoc, static_cast<float>(frame.screenWidth),
+                    static_cast<float>(frame.screenHeight));
+    state.setAttribArrays(GlState::attribBit(impostorCornerLoc) | GlState::attribBit(impostorShapeLoc) |
+                          GlState::attribBit(impostorColorLoc));
+    state.attribPointer(impostorCornerLoc, 2, GL_FLOAT, GL_FALSE, stride, offset);
+    state.attribPointer(impostorShapeLoc, 4, GL_FLOAT, GL_FALSE, stride, offset + 2 * sizeof(float));
+    state.attribPointer(impostorColorLoc, 3, GL_FLOAT, GL_FALSE, stride, offset + 6 * sizeof(float));
+
+    // Balls overlap in submission order like the mesh path
+    state.setBlend(true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(frame.circles->size() * 6));
+    state.setBlend(false);
+
+    // Back to the flat program for the particles
+    state.useProgram(shaderProgram);
+    state.setAttribArrays(GlState::attribBit(positionLoc));
+    state.attribPointer(positionLoc, 2, GL_FLOAT, GL_FALSE, 0, 0);
+}
+
+void GlesBackend::renderParticles(const std::vector<Particle>& particles) {
+    // Draw particles as small squares, uploaded together
+    particleVertices.resize(particles.size() * 8);
+    float* vertex = particleVertices.data();
+    for (const auto& particle : particles) {
+        float halfSize = particle.size / 2.0f;
+        *vertex++ = particle.x - halfSize;
+        *vertex++ = particle.y - halfSize;
+        *vertex++ = particle.x + halfSize;
+        *vertex++ = particle.y - halfSize;
+        *vertex++ = particle.x + halfSize;
+        *vertex++ = particle.y + halfSize;
+        *vertex++ = particle.x - halfSize;
+        *vertex++ = particle.y + halfSize;
+    }
+
+    size_t offset = stream.upload(state, particleVertices.data(), particleVertices.size() * sizeof(float));
+    GLint first = static_cast<GLint>(offset / (2 * sizeof(float)));
+
+    for (const auto& particle : particles) {
+        // Fade out based on lifetime
+        float alpha = 1.0f - (particle.lifetime / particle.maxLifetime);
+        state.uniform4f(colorLoc, particle.colorR, particle.colorG, particle.colorB, alpha);
+
+        glDrawArrays(GL_TRIANGLE_FAN, first, 4);
+        first += 4;
+    }
+}
+
+void GlesBackend::renderPackedParticles(const std::vector<PackedParticle>& particles, const FrameData& frame,
+                                        const float* projection) {
+    // Straight from the simulation's array: one upload, one draw
+    size_t offset = stream.upload(state, particles.data(), particles.size() * sizeof(PackedParticle));
+    const GLsizei stride = sizeof(PackedParticle);
+
+    state.useProgram(packedParticleProgram);
+    state.uniformMatrix4(packedMvpLoc, projection);
+    state.uniform2f(packedScreenSizeLoc, static_cast<float>(frame.screenWidth),
+                    static_cast<float>(frame.screenHeight));
+    state.setAttribArrays(GlState::attribBit(packedPositionLoc) | GlState::attribBit(packedColorLoc) |
+                          GlState::attribBit(packedSizeLoc));
+    state.attribPointer(packedPositionLoc, 2, GL_SHORT, GL_TRUE, stride, offset + offsetof(PackedParticle, x));
+    state.attribPointer(packedColorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                        offset + offsetof(PackedParticle, color));
+    state.attribPointer(packedSizeLoc, 1, GL_UNSIGNED_BYTE, GL_FALSE, stride,
+                        offset + offsetof(PackedParticle, size));
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(particles.size()));
+}
+
+void GlesBackend::renderParticleSpawns(const ParticleSpawnRing& spawns, float time, const float* projection) {
+    // Per explosion: four uniforms and a draw per PARTICLES_PER_DRAW
+    // particles, whatever the particle count
+    const GLsizei stride = sizeof(ParticleTemplateVertex);
+    state.useProgram(particleProgram);
+    state.uniformMatrix4(particleMvpLoc, projection);
+    state.uniform1f(particleTimeLoc, time);
+    state.bindArrayBuffer(particleTemplateVbo);
+    state.setAttribArrays(GlState::attribBit(particleIndexLoc) | GlState::attribBit(particleCornerLoc));
+    state.attribPointer(particleIndexLoc, 1, GL_UNSIGNED_SHORT, GL_FALSE, stride, 0);
+    state.attribPointer(particleCornerLoc, 2, GL_BYTE, GL_FALSE, stride, offsetof(ParticleTemplateVertex, cornerX));
+
+    for (size_t i = 0; i < spawns.size(); i++) {
+        const ParticleSpawn& spawn = spawns[i];
+        // Fully faded but not yet retired (an older record holds the ring)
+        if (time - spawn.spawnTime >= spawn.lifetimeMax) continue;
+
+        state.uniform4f(particleOriginLoc, spawn.x, spawn.y, spawn.spawnTime, spawn.seed);
+        state.uniform4f(particleColorLoc, spawn.colorR, spawn.colorG, spawn.colorB, spawn.colorJitter);
+        state.uniform4f(particleShapeLoc, spawn.sizeMin, spawn.sizeMax, spawn.speedMin, spawn.speedMax);
+        state.uniform4f(particleMotionLoc, spawn.upwardBias, spawn.gravity, spawn.lifetimeMin, spawn.lifetimeMax);
+        for (uint32_t first = 0; first < spawn.count; first += PARTICLES_PER_DRAW) {
+            uint32_t count = std::min<uint32_t>(spawn.count - first, PARTICLES_PER_DRAW);
+            state.uniform1f(particleIndexBaseLoc, static_cast<float>(first));
+            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count * 6));
+        }
+    }
+}
+
+void GlesBackend::renderHud(const Hud& hud) {
+    if (!hudProgram) return;
+
+    if (hud.getVersion() != hudVersion) {
+        const std::vector<float>& vertices = hud.getVertices();
+        state.bindArrayBuffer(hudVbo);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        hudVertexCount = hud.getVertexCount();
+        hudVersion = hud.getVersion();
+    }
+    if (hudVertexCount == 0) return;
+
+    state.useProgram(hudProgram);
+
+    state.bindTexture2D(0, hudTexture);
+    state.uniform1i(hudAtlasLoc, 0);
+    state.uniform1f(hudSmoothingLoc, hud.getSmoothing());
+    if (hud.isDarkText()) {
+        state.uniform4f(hudFillColorLoc, 0.0f, 0.0f, 0.0f, 1.0f);
+        state.uniform4f(hudOutlineColorLoc, 1.0f, 1.0f, 1.0f, 0.8f);
+    } else {
+        state.uniform4f(hudFillColorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+        state.uniform4f(hudOutlineColorLoc, 0.0f, 0.0f, 0.0f, 0.8f);
+    }
+
+    const GLsizei stride = Hud::FLOATS_PER_VERTEX * sizeof(float);
+    state.bindArrayBuffer(hudVbo);
+    state.setAttribArrays(GlState::attribBit(hudPositionLoc) | GlState::attribBit(hudTexCoordLoc));
+    state.attribPointer(hudPositionLoc, 2, GL_FLOAT, GL_FALSE, stride, 0);
+    state.attribPointer(hudTexCoordLoc, 2, GL_FLOAT, GL_FALSE, stride, 2 * sizeof(float));
+
+    state.setBlend(true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLES, 0, hudVertexCount);
+}
+
+void GlesBackend::present() {
+    eglSwapBuffers(display, surface);
+}
+
+void GlesBackend::finish() {
+    glFinish();
+}
+
+bool GlesBackend::nextFrameId(uint64_t* frameId) {
+    if (!eglGetNextFrameIdANDROIDFn) return false;
+
+    EGLuint64KHR id = 0;
+    if (!eglGetNextFrameIdANDROIDFn(display, surface, &id)) return false;
+    *frameId = id;
+    return true;
+}
+
+PresentTimeStatus GlesBackend::queryPresentTime(uint64_t frameId, int64_t* presentNs) {
+    if (!eglGetFrameTimestampsANDROIDFn) return PRESENT_TIME_UNKNOWN;
+
+    const EGLint name = EGL_DISPLAY_PRESENT_TIME_ANDROID;
+    EGLnsecsANDROID presentTime = EGL_TIMESTAMP_PENDING_ANDROID;
+    if (!eglGetFrameTimestampsANDROIDFn(display, surface, frameId, 1, &name, &presentTime) ||
+        presentTime == EGL_TIMESTAMP_INVALID_ANDROID) {
+        return PRESENT_TIME_UNKNOWN;
+    }
+    if (presentTime == EGL_TIMESTAMP_PENDING_ANDROID) {
+        return PRESENT_TIME_PENDING;
+    }
+    *presentNs = presentTime;
+    return PRESENT_TIME_AVAILABLE;
+}
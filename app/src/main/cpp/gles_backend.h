@@ -0,0 +1,139 @@
+#ifndef TOUCHGAME_GLES_BACKEND_H
+#define TOUCHGAME_GLES_BACKEND_H
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include "gl_state.h"
+#include "render_backend.h"
+#include "sdf_font.h"
+#include "stream_buffer.h"
+#include <vector>
+
+struct Circle;
+struct PackedParticle;
+struct Particle;
+class Hud;
+class ParticleSpawnRing;
+
+// OpenGL ES 2.0 renderer on an EGL window surface (or pbuffer offscreen)
+class GlesBackend : public RenderBackend {
+public:
+    GlesBackend();
+    ~GlesBackend() override;
+
+    const char* getName() const override { return "gles2"; }
+
+    bool init(void* nativeWindow, int width, int height, const std::string& cacheDir) override;
+    bool preload(const std::string& cacheDir) override;
+    int getWidth() const override { return surfaceWidth; }
+    int getHeight() const override { return surfaceHeight; }
+
+    bool makeCurrent() override;
+    void drawFrame(const FrameData& frame) override;
+    void present() override;
+    void finish() override;
+
+    bool setBallStyle(BallStyle style) override {
+        ballStyle = style;
+        return true;
+    }
+    BallStyle getBallStyle() const override { return ballStyle; }
+
+    bool supportsParticleMode(ParticleMode mode) const override { (void)mode; return true; }
+
+    bool supportsPresentTimes() const override { return eglGetFrameTimestampsANDROIDFn != nullptr; }
+    bool nextFrameId(uint64_t* frameId) override;
+    PresentTimeStatus queryPresentTime(uint64_t frameId, int64_t* presentNs) override;
+
+    std::string getStatsReport() const override { return state.report() + stream.report(); }
+    void resetStats() override {
+        state.resetCounters();
+        stream.resetCounters();
+    }
+
+private:
+    bool initContext(EGLint surfaceType);
+    bool createSurface(void* nativeWindow, int width, int height);
+    bool setupFrameTimestamps();
+    void setupShaders();
+    void setupHud(const std::string& cacheDir);
+    void renderCircle(const FrameData& frame, const Circle& circle);
+    void renderImpostors(const FrameData& frame, const float* projection);
+    void renderParticles(const std::vector<Particle>& particles);
+    void renderPackedParticles(const std::vector<PackedParticle>& particles, const FrameData& frame,
+                               const float* projection);
+    void renderParticleSpawns(const ParticleSpawnRing& spawns, float time, const float* projection);
+    void renderHud(const Hud& hud);
+
+    // EGL
+    EGLDisplay display;
+    EGLSurface surface;
+    EGLContext context;
+    EGLConfig config;
+    bool preloaded;          // context and resources made by preload()
+    int surfaceWidth;
+    int surfaceHeight;
+    PFNEGLGETNEXTFRAMEIDANDROIDPROC eglGetNextFrameIdANDROIDFn;
+    PFNEGLGETFRAMETIMESTAMPSANDROIDPROC eglGetFrameTimestampsANDROIDFn;
+
+    // Per-frame binds, enables and uniforms go through here; creation and
+    // uploads call GL directly
+    GlState state;
+
+    // OpenGL resources
+    GLuint shaderProgram;
+    StreamBuffer stream;     // circle and particle vertices
+    std::vector<float> particleVertices;
+    GLuint impostorProgram;
+    GLint impostorCornerLoc;
+    GLint impostorShapeLoc;
+    GLint impostorColorLoc;
+    GLint impostorMvpLoc;
+    GLint impostorScreenSizeLoc;
+    std::vector<float> impostorVertices;
+    BallStyle ballStyle;
+    // GPU particles: larger explosions take several draws
+    static const int PARTICLES_PER_DRAW = 16384;
+    GLuint particleProgram;
+    GLuint particleTemplateVbo;
+    GLint particleIndexLoc;
+    GLint particleCornerLoc;
+    GLint particleMvpLoc;
+    GLint particleOriginLoc;
+    GLint particleColorLoc;
+    GLint particleShapeLoc;
+    GLint particleMotionLoc;
+    GLint particleIndexBaseLoc;
+    GLint particleTimeLoc;
+    GLuint packedParticleProgram;
+    GLint packedPositionLoc;
+    GLint packedColorLoc;
+    GLint packedSizeLoc;
+    GLint packedMvpLoc;
+    GLint packedScreenSizeLoc;
+    GLint positionLoc;
+    GLint colorLoc;
+    GLint mvpLoc;
+    GLuint gradientShaderProgram;
+    GLuint gradientVbo;
+    GLint gradientPositionLoc;
+    GLint gradientColor1Loc;
+    GLint gradientColor2Loc;
+
+    // HUD
+    SdfFont font;
+    GLuint hudProgram;
+    GLuint hudTexture;
+    GLuint hudVbo;
+    GLint hudPositionLoc;
+    GLint hudTexCoordLoc;
+    GLint hudAtlasLoc;
+    GLint hudFillColorLoc;
+    GLint hudOutlineColorLoc;
+    GLint hudSmoothingLoc;
+    uint32_t hudVersion;     // Hud::getVersion() last uploaded
+    int hudVertexCount;
+};
+
+#endif // TOUCHGAME_GLES_BACKEND_H
@@ -0,0 +1,332 @@
+#include "batch_sim.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// Reusable barrier; std::barrier is C++20
+class Barrier {
+public:
+    explicit Barrier(int count) : count(count), waiting(0), generation(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        unsigned long arrivedGeneration = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return generation != arrivedGeneration; });
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    int count;
+    int waiting;
+    unsigned long generation;
+};
+
+struct GameSlot {
+    std::unique_ptr<Game> game;
+    std::unique_ptr<InputPolicy> policy;
+    uint32_t index;
+    uint32_t seed;
+    int round;
+    int circles;
+    float roundStart;
+    int hits;
+    int misses;
+};
+
+void closeRound(GameSlot& slot, RoundColumns& out, float now, bool cleared) {
+    out.game.push_back(slot.index);
+    out.seed.push_back(slot.seed);
+    out.round.push_back(slot.round);
+    out.circles.push_back(slot.circles);
+    out.startTime.push_back(slot.roundStart);
+    out.clearTime.push_back(now - slot.roundStart);
+    out.hits.push_back(slot.hits);
+    out.misses.push_back(slot.misses);
+    out.cleared.push_back(cleared ? 1 : 0);
+
+    slot.round = slot.game->getRound();
+    slot.circles = static_cast<int>(slot.game->getCircles().size());
+    slot.roundStart = now;
+    slot.hits = 0;
+    slot.misses = 0;
+}
+
+void stepGame(GameSlot& slot, RoundColumns& out, float now, float dt) {
+    Game& game = *slot.game;
+
+    float x, y;
+    if (slot.policy->nextTouch(game, now, x, y)) {
+        if (game.handleTouch(x, y)) {
+            slot.hits++;
+        } else {
+            slot.misses++;
+        }
+        if (game.getRound() != slot.round) {
+            closeRound(slot, out, now, true);
+        }
+    }
+
+    game.update(dt);
+}
+
+template <typename T>
+void appendColumn(std::vector<T>& dst, const std::vector<T>& src) {
+    dst.insert(dst.end(), src.begin(), src.end());
+}
+
+template <typename T>
+bool writeColumn(std::ofstream& out, const char* name, char type, const std::vector<T>& values) {
+    uint8_t nameLength = static_cast<uint8_t>(strlen(name));
+    out.write(reinterpret_cast<const char*>(&nameLength), 1);
+    out.write(name, nameLength);
+    out.write(&type, 1);
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    return out.good();
+}
+
+} // namespace
+
+void RoundColumns::append(const RoundColumns& other) {
+    appendColumn(game, other.game);
+    appendColumn(seed, other.seed);
+    appendColumn(round, other.round);
+    appendColumn(circles, other.circles);
+    appendColumn(startTime, other.startTime);
+    appendColumn(clearTime, other.clearTime);
+    appendColumn(hits, other.hits);
+    appendColumn(misses, other.misses);
+    appendColumn(cleared, other.cleared);
+}
+
+ScriptedPolicy::ScriptedPolicy(std::vector<ScriptedTouch> script, bool loop)
+    : script(std::move(script)), loop(loop), next(0), timeOffset(0.0f) {
+    std::sort(this->script.begin(), this->script.end(),
+              [](const ScriptedTouch& a, const ScriptedTouch& b) { return a.time < b.time; });
+}
+
+void ScriptedPolicy::reset(uint32_t) {
+    next = 0;
+    timeOffset = 0.0f;
+}
+
+bool ScriptedPolicy::nextTouch(const Game& game, float time, float& x, float& y) {
+    if (script.empty()) return false;
+
+    if (next >= script.size()) {
+        if (!loop || script.back().time <= 0.0f) return false;
+        timeOffset += script.back().time;
+        next = 0;
+    }
+
+    const ScriptedTouch& touch = script[next];
+    if (touch.time + timeOffset > time) return false;
+
+    x = touch.x * game.getScreenWidth();
+    y = touch.y * game.getScreenHeight();
+    next++;
+    return true;
+}
+
+bool ScriptedPolicy::load(const std::string& path, std::vector<ScriptedTouch>& script) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        ScriptedTouch touch;
+        if (fields >> touch.time >> touch.x >> touch.y) {
+            script.push_back(touch);
+        }
+    }
+    return true;
+}
+
+RandomTapPolicy::RandomTapPolicy(float tapsPerSecond)
+    : interval(1.0f / tapsPerSecond), nextTapTime(0.0f), dist01(0.0f, 1.0f) {
+}
+
+void RandomTapPolicy::reset(uint32_t seed) {
+    rng.seed(seed ^ 0x9e3779b9u);
+    nextTapTime = interval;
+}
+
+bool RandomTapPolicy::nextTouch(const Game& game, float time, float& x, float& y) {
+    if (time < nextTapTime) return false;
+
+    nextTapTime += interval;
+    x = dist01(rng) * game.getScreenWidth();
+    y = dist01(rng) * game.getScreenHeight();
+    return true;
+}
+
+ChaseBotPolicy::ChaseBotPolicy(float reactionTime, float aimErrorPx)
+    : reactionTime(reactionTime), aimErrorPx(std::max(0.0f, aimErrorPx)), nextTapTime(0.0f),
+      aimError(0.0f, 1.0f) {
+}
+
+void ChaseBotPolicy::reset(uint32_t seed) {
+    rng.seed(seed ^ 0x85ebca6bu);
+    aimError.reset();
+    nextTapTime = reactionTime;
+}
+
+bool ChaseBotPolicy::nextTouch(const Game& game, float time, float& x, float& y) {
+    const std::vector<Circle>& circles = game.getCircles();
+    if (time < nextTapTime || circles.empty()) return false;
+
+    // Nearest circle to the screen center
+    float centerX = game.getScreenWidth() * 0.5f;
+    float centerY = game.getScreenHeight() * 0.5f;
+    const Circle* target = &circles[0];
+    float bestDist = INFINITY;
+    for (const auto& circle : circles) {
+        float dx = circle.x - centerX;
+        float dy = circle.y - centerY;
+        float dist = dx * dx + dy * dy;
+        if (dist < bestDist) {
+            bestDist = dist;
+            target = &circle;
+        }
+    }
+
+    // The player reacts to what they saw one reaction time ago
+    x = target->x - target->velocityX * reactionTime;
+    y = target->y - target->velocityY * reactionTime;
+    if (aimErrorPx > 0.0f) {
+        x += aimError(rng) * aimErrorPx;
+        y += aimError(rng) * aimErrorPx;
+    }
+    nextTapTime = time + reactionTime;
+    return true;
+}
+
+AutoplayerPolicy::AutoplayerPolicy(const AutoplayerConfig& config) : player(config) {
+}
+
+void AutoplayerPolicy::reset(uint32_t seed) {
+    player.reset(seed);
+}
+
+bool AutoplayerPolicy::nextTouch(const Game& game, float time, float& x, float& y) {
+    return player.update(game, time, x, y);
+}
+
+BatchResult runBatch(const BatchConfig& config) {
+    BatchResult result;
+    if (config.gameCount <= 0 || !config.policyFactory) return result;
+
+    int threadCount = config.threadCount;
+    if (threadCount <= 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, config.gameCount);
+    result.threadCount = threadCount;
+
+    const long totalTicks = static_cast<long>(std::ceil(config.duration / config.timeStep));
+    const long ticksPerEpoch = std::max(1, config.ticksPerEpoch);
+
+    std::vector<RoundColumns> threadColumns(threadCount);
+    Barrier barrier(threadCount);
+
+    auto worker = [&](int threadIndex) {
+        int begin = static_cast<int>(static_cast<long>(config.gameCount) * threadIndex / threadCount);
+        int end = static_cast<int>(static_cast<long>(config.gameCount) * (threadIndex + 1) / threadCount);
+        RoundColumns& out = threadColumns[threadIndex];
+
+        // Each thread builds its own games so they live in its local memory
+        std::vector<GameSlot> slots(end - begin);
+        for (int i = begin; i < end; i++) {
+            GameSlot& slot = slots[i - begin];
+            slot.index = static_cast<uint32_t>(i);
+            slot.seed = config.firstSeed + static_cast<uint32_t>(i);
+            slot.game.reset(new Game(slot.seed));
+            slot.game->setLevelTable(config.levels);
+            slot.game->init(config.screenWidth, config.screenHeight);
+            if (config.startRound > 1) {
+                slot.game->startRound(config.startRound);
+            }
+            slot.policy = config.policyFactory();
+            slot.policy->reset(slot.seed);
+            slot.round = slot.game->getRound();
+            slot.circles = static_cast<int>(slot.game->getCircles().size());
+            slot.roundStart = 0.0f;
+            slot.hits = 0;
+            slot.misses = 0;
+        }
+
+        for (long epochStart = 0; epochStart < totalTicks; epochStart += ticksPerEpoch) {
+            long epochEnd = std::min(totalTicks, epochStart + ticksPerEpoch);
+            for (long tick = epochStart; tick < epochEnd; tick++) {
+                float now = static_cast<float>(tick * static_cast<double>(config.timeStep));
+                for (auto& slot : slots) {
+                    stepGame(slot, out, now, config.timeStep);
+                }
+            }
+            // Keep every game on the same tick boundary
+            barrier.wait();
+        }
+
+        float endTime = static_cast<float>(totalTicks * static_cast<double>(config.timeStep));
+        for (auto& slot : slots) {
+            closeRound(slot, out, endTime, false);
+        }
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    result.simulatedGameSeconds = static_cast<double>(config.gameCount) * totalTicks * config.timeStep;
+
+    for (const auto& columns : threadColumns) {
+        result.rounds.append(columns);
+    }
+    return result;
+}
+
+bool writeColumnar(const RoundColumns& columns, const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    const uint32_t columnCount = 9;
+    const uint64_t rowCount = columns.size();
+    out.write("TGCOLS01", 8);
+    out.write(reinterpret_cast<const char*>(&columnCount), sizeof(columnCount));
+    out.write(reinterpret_cast<const char*>(&rowCount), sizeof(rowCount));
+
+    return writeColumn(out, "game", 'u', columns.game) &&
+           writeColumn(out, "seed", 'u', columns.seed) &&
+           writeColumn(out, "round", 'i', columns.round) &&
+           writeColumn(out, "circles", 'i', columns.circles) &&
+           writeColumn(out, "start_time", 'f', columns.startTime) &&
+           writeColumn(out, "clear_time", 'f', columns.clearTime) &&
+           writeColumn(out, "hits", 'i', columns.hits) &&
+           writeColumn(out, "misses", 'i', columns.misses) &&
+           writeColumn(out, "cleared", 'b', columns.cleared);
+}
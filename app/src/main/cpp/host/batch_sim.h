@@ -0,0 +1,146 @@
+#ifndef TOUCHGAME_BATCH_SIM_H
+#define TOUCHGAME_BATCH_SIM_H
+
+#include "autoplayer.h"
+#include "game.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Headless batch simulation for tuning the difficulty curve.
+//
+// Runs many independent seeded Games in lockstep across worker threads,
+// feeds them touches from an InputPolicy and records per-round statistics.
+
+// Decides where and when a simulated player touches the screen
+class InputPolicy {
+public:
+    virtual ~InputPolicy() {}
+
+    virtual void reset(uint32_t seed) = 0;
+    // Called once per tick before the game is updated. Returns true and
+    // fills x/y (pixels) to touch this tick.
+    virtual bool nextTouch(const Game& game, float time, float& x, float& y) = 0;
+};
+
+// Replays a fixed list of touches in normalized screen coordinates (0-1),
+// optionally looping with the script's duration as the period
+struct ScriptedTouch {
+    float time;
+    float x;
+    float y;
+};
+
+class ScriptedPolicy : public InputPolicy {
+public:
+    ScriptedPolicy(std::vector<ScriptedTouch> script, bool loop);
+
+    void reset(uint32_t seed) override;
+    bool nextTouch(const Game& game, float time, float& x, float& y) override;
+
+    static bool load(const std::string& path, std::vector<ScriptedTouch>& script);
+
+private:
+    std::vector<ScriptedTouch> script;
+    bool loop;
+    size_t next;
+    float timeOffset;
+};
+
+// Taps uniformly random positions at a fixed rate
+class RandomTapPolicy : public InputPolicy {
+public:
+    explicit RandomTapPolicy(float tapsPerSecond);
+
+    void reset(uint32_t seed) override;
+    bool nextTouch(const Game& game, float time, float& x, float& y) override;
+
+private:
+    float interval;
+    float nextTapTime;
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> dist01;
+};
+
+// Aims at the nearest circle where it was one reaction time ago, with
+// Gaussian aim error (none when aimErrorPx <= 0) and a reaction-time pause
+// between taps
+class ChaseBotPolicy : public InputPolicy {
+public:
+    ChaseBotPolicy(float reactionTime, float aimErrorPx);
+
+    void reset(uint32_t seed) override;
+    bool nextTouch(const Game& game, float time, float& x, float& y) override;
+
+private:
+    float reactionTime;
+    float aimErrorPx;
+    float nextTapTime;
+    std::mt19937 rng;
+    std::normal_distribution<float> aimError; // unit; scaled by aimErrorPx
+};
+
+// The Autoplayer the device's debug toggle uses: taps where a circle will
+// be after the reaction time, wall bounces included
+class AutoplayerPolicy : public InputPolicy {
+public:
+    explicit AutoplayerPolicy(const AutoplayerConfig& config);
+
+    void reset(uint32_t seed) override;
+    bool nextTouch(const Game& game, float time, float& x, float& y) override;
+
+private:
+    Autoplayer player;
+};
+
+typedef std::function<std::unique_ptr<InputPolicy>()> PolicyFactory;
+
+struct BatchConfig {
+    int gameCount = 1000;
+    uint32_t firstSeed = 1;      // game i uses firstSeed + i
+    int screenWidth = 1080;
+    int screenHeight = 1920;
+    float timeStep = 1.0f / 60.0f;
+    float duration = 120.0f;     // simulated seconds per game
+    int startRound = 1;          // games jump here right after init
+    int threadCount = 0;         // 0 = hardware concurrency
+    int ticksPerEpoch = 600;     // ticks between lockstep barriers
+    PolicyFactory policyFactory;
+    const LevelTable* levels = nullptr; // shared read-only; null = built-in curve
+};
+
+// One row per round played. Columns are kept separate so the output file
+// and any analysis can read a single field without touching the others.
+struct RoundColumns {
+    std::vector<uint32_t> game;
+    std::vector<uint32_t> seed;
+    std::vector<int32_t> round;
+    std::vector<int32_t> circles;
+    std::vector<float> startTime;   // seconds since game start
+    std::vector<float> clearTime;   // seconds spent in the round
+    std::vector<int32_t> hits;
+    std::vector<int32_t> misses;
+    std::vector<uint8_t> cleared;   // 0 if the simulation ended mid-round
+
+    size_t size() const { return round.size(); }
+    void append(const RoundColumns& other);
+};
+
+struct BatchResult {
+    RoundColumns rounds;
+    double wallSeconds = 0.0;
+    double simulatedGameSeconds = 0.0;
+    int threadCount = 0;
+};
+
+BatchResult runBatch(const BatchConfig& config);
+
+// Writes the columns as a flat binary file:
+//   "TGCOLS01", uint32 columnCount, uint64 rowCount, then per column
+//   uint8 nameLength, name bytes, uint8 type ('u'=u32, 'i'=i32, 'f'=f32,
+//   'b'=u8) and rowCount packed little-endian values.
+bool writeColumnar(const RoundColumns& columns, const std::string& path);
+
+#endif // TOUCHGAME_BATCH_SIM_H
@@ -0,0 +1,192 @@
+// touchgame_entity_bench: float vs packed entity storage.
+//
+//   touchgame_entity_bench --count 1000000 --steps 60
+//
+// Fills arrays of circles and particles in both layouts (game.h/particles.h
+// float structs, packed_entities.h quantized ones) with the same entities,
+// runs the update kernels over them for a second of 60 Hz steps and reports
+// bytes per entity, update throughput and the memory traffic that implies
+// (each step reads and writes every entity once). Lifetimes are long enough
+// that no particle expires, so every step touches all of them. The last
+// columns are how far the packed entities drifted from the float ones.
+
+#include "game.h"
+#include "packed_entities.h"
+#include "particles.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+static void usage() {
+    fprintf(stderr,
+        "usage: touchgame_entity_bench [options]\n"
+        "  --count N          entities of each kind (default 1000000)\n"
+        "  --steps N          updates per run, at 60 Hz (default 60)\n"
+        "  --runs N           runs per kernel; the fastest is reported (default 5)\n"
+        "  --size WxH         screen size in pixels (default 1080x1920)\n");
+}
+
+static const float kDeltaTime = 1.0f / 60.0f;
+static const float kGravity = 600.0f;
+
+// Best of `runs` timings of `steps` updates, each on a fresh copy
+template <typename Entity, typename Update>
+static double timeKernel(const std::vector<Entity>& initial, int steps, int runs, Update update,
+                         std::vector<Entity>* result) {
+    double best = 1e30;
+    for (int run = 0; run < runs; run++) {
+        std::vector<Entity> entities = initial;
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step < steps; step++) {
+            update(entities);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+        if (run == runs - 1) *result = entities;
+    }
+    return best;
+}
+
+static void printRow(const char* name, size_t bytes, size_t count, int steps, double seconds,
+                     double maxError, double meanError) {
+    double updates = static_cast<double>(count) * steps;
+    printf("%-16s %6zu %11.2f %11.1f %9.2f", name, bytes, seconds * 1e9 / updates, updates / seconds / 1e6,
+           2.0 * bytes * updates / seconds / 1e9);
+    if (maxError >= 0.0) {
+        printf(" %9.3f %9.3f", maxError, meanError);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    int count = 1000000;
+    int steps = 60;
+    int runs = 5;
+    int width = 1080;
+    int height = 1920;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--count" && hasValue) {
+            count = atoi(argv[++i]);
+        } else if (arg == "--steps" && hasValue) {
+            steps = atoi(argv[++i]);
+        } else if (arg == "--runs" && hasValue) {
+            runs = atoi(argv[++i]);
+        } else if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2) {
+                usage();
+                return 1;
+            }
+        } else {
+            usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (count <= 0 || steps <= 0 || runs <= 0 || width <= 0 || height <= 0) {
+        usage();
+        return 1;
+    }
+
+    // Entities shaped like the game's: round-sized balls at round speeds,
+    // explosion particles flung from across the screen
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float minDimension = static_cast<float>(std::min(width, height));
+
+    std::vector<Circle> circles(count);
+    for (Circle& circle : circles) {
+        float angle = unit(rng) * 2.0f * static_cast<float>(M_PI);
+        float speed = 300.0f + unit(rng) * 900.0f;
+        circle.radius = minDimension * (0.03f + unit(rng) * 0.07f);
+        circle.x = circle.radius + unit(rng) * (width - 2.0f * circle.radius);
+        circle.y = circle.radius + unit(rng) * (height - 2.0f * circle.radius);
+        circle.velocityX = cosf(angle) * speed;
+        circle.velocityY = sinf(angle) * speed;
+        circle.colorR = unit(rng);
+        circle.colorG = unit(rng);
+        circle.colorB = unit(rng);
+        circle.flashTimer = unit(rng) < 0.1f ? 0.15f : 0.0f;
+    }
+
+    std::vector<Particle> particles(count);
+    for (Particle& particle : particles) {
+        float angle = unit(rng) * 2.0f * static_cast<float>(M_PI);
+        float speed = 200.0f + unit(rng) * 400.0f;
+        particle.x = unit(rng) * width;
+        particle.y = unit(rng) * height;
+        particle.velocityX = cosf(angle) * speed;
+        particle.velocityY = sinf(angle) * speed - 200.0f;
+        particle.size = minDimension * 0.05f * (0.15f + unit(rng) * 0.1f);
+        particle.colorR = unit(rng);
+        particle.colorG = unit(rng);
+        particle.colorB = unit(rng);
+        particle.lifetime = 0.0f;
+        particle.maxLifetime = 3.0f + unit(rng) * 0.9f;
+    }
+
+    std::vector<PackedCircle> packedCircles(count);
+    std::vector<PackedParticle> packedParticles(count);
+    for (int i = 0; i < count; i++) {
+        packedCircles[i] = packCircle(circles[i], width, height);
+        packedParticles[i] = packParticle(particles[i], width, height);
+    }
+
+    std::vector<Circle> circlesOut;
+    std::vector<PackedCircle> packedCirclesOut;
+    std::vector<Particle> particlesOut;
+    std::vector<PackedParticle> packedParticlesOut;
+
+    double circleSeconds = timeKernel(circles, steps, runs, [&](std::vector<Circle>& entities) {
+        updateCircles(entities, kDeltaTime, width, height);
+    }, &circlesOut);
+    double packedCircleSeconds = timeKernel(packedCircles, steps, runs, [&](std::vector<PackedCircle>& entities) {
+        updatePackedCircles(entities, kDeltaTime, width, height);
+    }, &packedCirclesOut);
+    double particleSeconds = timeKernel(particles, steps, runs, [&](std::vector<Particle>& entities) {
+        updateParticles(entities, kDeltaTime, kGravity);
+    }, &particlesOut);
+    double packedParticleSeconds = timeKernel(packedParticles, steps, runs,
+                                              [&](std::vector<PackedParticle>& entities) {
+        updatePackedParticles(entities, kDeltaTime, kGravity, height);
+    }, &packedParticlesOut);
+
+    // Position drift of the packed entities after the run, in pixels. A
+    // circle that bounced a step apart in the two layouts counts too.
+    double circleMax = 0.0, circleSum = 0.0, particleMax = 0.0, particleSum = 0.0;
+    for (int i = 0; i < count; i++) {
+        Circle circle = unpackCircle(packedCirclesOut[i], width, height);
+        double error = hypot(circle.x - circlesOut[i].x, circle.y - circlesOut[i].y);
+        circleMax = std::max(circleMax, error);
+        circleSum += error;
+    }
+    size_t particleCount = std::min(particlesOut.size(), packedParticlesOut.size());
+    for (size_t i = 0; i < particleCount; i++) {
+        Particle particle = unpackParticle(packedParticlesOut[i], width, height);
+        double error = hypot(particle.x - particlesOut[i].x, particle.y - particlesOut[i].y);
+        particleMax = std::max(particleMax, error);
+        particleSum += error;
+    }
+
+    printf("%d entities of each kind, %d steps at 60 Hz, %dx%d, best of %d runs\n", count, steps, width, height,
+           runs);
+    printf("%-16s %6s %11s %11s %9s %9s %9s\n", "layout", "bytes", "ns/update", "M updates/s", "GB/s",
+           "max px", "mean px");
+    printRow("Circle", sizeof(Circle), count, steps, circleSeconds, -1.0, 0.0);
+    printRow("PackedCircle", sizeof(PackedCircle), count, steps, packedCircleSeconds, circleMax,
+             circleSum / count);
+    printRow("Particle", sizeof(Particle), count, steps, particleSeconds, -1.0, 0.0);
+    printRow("PackedParticle", sizeof(PackedParticle), count, steps, packedParticleSeconds, particleMax,
+             particleCount ? particleSum / particleCount : 0.0);
+    if (particlesOut.size() != packedParticlesOut.size()) {
+        printf("warning: %zu float and %zu packed particles left\n", particlesOut.size(),
+               packedParticlesOut.size());
+    }
+    return 0;
+}
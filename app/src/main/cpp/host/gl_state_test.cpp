@@ -0,0 +1,154 @@
+// touchgame_gl_state_test: GlState's redundant-call elision against the
+// mock GL (host/mock_gl.cpp). Each check compares the calls that reached
+// the "driver" with what the cache was asked for; run by ctest.
+
+#include "gl_state.h"
+#include "host/mock_gl.h"
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK_EQ(actual, expected)                                                          \
+    do {                                                                                    \
+        unsigned long long a = (actual), e = (expected);                                    \
+        if (a != e) {                                                                       \
+            fprintf(stderr, "%s:%d: %s is %llu, expected %llu\n", __FILE__, __LINE__, #actual, \
+                    a, e);                                                                  \
+            failures++;                                                                     \
+        }                                                                                   \
+    } while (0)
+
+static void testProgramAndBuffer() {
+    GlState state;
+    mockgl::reset();
+
+    state.useProgram(5);
+    state.useProgram(5);
+    CHECK_EQ(mockgl::calls("glUseProgram"), 1);
+    CHECK_EQ(state.getElided(GlState::CALL_USE_PROGRAM), 1);
+    state.useProgram(6);
+    CHECK_EQ(mockgl::calls("glUseProgram"), 2);
+
+    state.bindArrayBuffer(1);
+    state.bindArrayBuffer(1);
+    CHECK_EQ(mockgl::calls("glBindBuffer"), 1);
+    state.bindArrayBuffer(2);
+    CHECK_EQ(mockgl::calls("glBindBuffer"), 2);
+    CHECK_EQ(state.getIssued(GlState::CALL_BIND_BUFFER), 2);
+    CHECK_EQ(state.getElided(GlState::CALL_BIND_BUFFER), 1);
+
+    // Everything is reissued after invalidate()
+    state.invalidate();
+    state.useProgram(6);
+    state.bindArrayBuffer(2);
+    CHECK_EQ(mockgl::calls("glUseProgram"), 3);
+    CHECK_EQ(mockgl::calls("glBindBuffer"), 3);
+}
+
+static void testUniforms() {
+    GlState state;
+    mockgl::reset();
+
+    state.useProgram(1);
+    state.uniform4f(0, 1.0f, 0.5f, 0.25f, 1.0f);
+    state.uniform4f(0, 1.0f, 0.5f, 0.25f, 1.0f);
+    CHECK_EQ(mockgl::calls("glUniform4f"), 1);
+    state.uniform4f(0, 1.0f, 0.5f, 0.25f, 0.5f);
+    CHECK_EQ(mockgl::calls("glUniform4f"), 2);
+
+    // Values are remembered per program
+    state.useProgram(2);
+    state.uniform4f(0, 1.0f, 0.5f, 0.25f, 0.5f);
+    CHECK_EQ(mockgl::calls("glUniform4f"), 3);
+    state.useProgram(1);
+    state.uniform4f(0, 1.0f, 0.5f, 0.25f, 0.5f);
+    CHECK_EQ(mockgl::calls("glUniform4f"), 3);
+
+    // Inactive locations never reach GL
+    state.uniform1f(-1, 2.0f);
+    CHECK_EQ(mockgl::calls("glUniform1f"), 0);
+
+    state.invalidate();
+    state.useProgram(1);
+    state.uniform4f(0, 1.0f, 0.5f, 0.25f, 0.5f);
+    CHECK_EQ(mockgl::calls("glUniform4f"), 4);
+    CHECK_EQ(state.getIssued(GlState::CALL_UNIFORM), 4);
+    CHECK_EQ(state.getElided(GlState::CALL_UNIFORM), 3);
+}
+
+static void testAttributes() {
+    GlState state;
+    mockgl::reset();
+
+    // The mock reports GL_MAX_VERTEX_ATTRIBS = 8: after invalidate() all 8,
+    // and only those, are set explicitly
+    state.setAttribArrays(GlState::attribBit(0) | GlState::attribBit(12));
+    CHECK_EQ(mockgl::calls("glEnableVertexAttribArray"), 1);
+    CHECK_EQ(mockgl::calls("glDisableVertexAttribArray"), 7);
+    state.setAttribArrays(GlState::attribBit(0));
+    CHECK_EQ(mockgl::calls("glEnableVertexAttribArray"), 1);
+    CHECK_EQ(state.getElided(GlState::CALL_ATTRIB_ARRAY), 1);
+    state.setAttribArrays(GlState::attribBit(0) | GlState::attribBit(1));
+    CHECK_EQ(mockgl::calls("glEnableVertexAttribArray"), 2);
+    CHECK_EQ(mockgl::calls("glDisableVertexAttribArray"), 7);
+
+    // Optimized-out attributes contribute nothing to the mask
+    CHECK_EQ(GlState::attribBit(-1), 0);
+
+    // The pointer is bound to the array buffer: same buffer elides, a new
+    // buffer reissues
+    state.bindArrayBuffer(3);
+    state.attribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    state.attribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    CHECK_EQ(mockgl::calls("glVertexAttribPointer"), 1);
+    state.bindArrayBuffer(4);
+    state.attribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    CHECK_EQ(mockgl::calls("glVertexAttribPointer"), 2);
+    state.attribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 16);
+    CHECK_EQ(mockgl::calls("glVertexAttribPointer"), 3);
+
+    // Location -1 wraps to an index the cache ignores
+    state.attribPointer(static_cast<GLuint>(-1), 2, GL_FLOAT, GL_FALSE, 0, 0);
+    CHECK_EQ(mockgl::calls("glVertexAttribPointer"), 3);
+
+    state.invalidate();
+    state.bindArrayBuffer(4);
+    state.attribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 16);
+    CHECK_EQ(mockgl::calls("glVertexAttribPointer"), 4);
+}
+
+static void testBlendAndTextures() {
+    GlState state;
+    mockgl::reset();
+
+    state.setBlend(true);
+    state.setBlend(true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    CHECK_EQ(mockgl::calls("glEnable"), 1);
+    CHECK_EQ(mockgl::calls("glBlendFunc"), 1);
+    state.setBlend(false);
+    CHECK_EQ(mockgl::calls("glDisable"), 1);
+
+    state.bindTexture2D(0, 7);
+    state.bindTexture2D(0, 7);
+    CHECK_EQ(mockgl::calls("glActiveTexture"), 1);
+    CHECK_EQ(mockgl::calls("glBindTexture"), 1);
+    state.bindTexture2D(0, 8);
+    CHECK_EQ(mockgl::calls("glActiveTexture"), 1);
+    CHECK_EQ(mockgl::calls("glBindTexture"), 2);
+}
+
+int main() {
+    testProgramAndBuffer();
+    testUniforms();
+    testAttributes();
+    testBlendAndTextures();
+
+    if (failures > 0) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("all GlState checks passed\n");
+    return 0;
+}
@@ -0,0 +1,404 @@
+// touchgame_levelc: compiles levels.txt into the binary level table.
+//
+//   touchgame_levelc levels/levels.txt levels.bin
+//   touchgame_levelc --dump levels.bin
+//
+// The source format is described at the top of app/src/main/levels/levels.txt
+// and the output layout in level_table.h. The output is loaded back through
+// LevelTable before it is written, so anything this tool emits is a table
+// the game accepts.
+
+#include "level_table.h"
+#include "packed_entities.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Curve {
+    int rounds = 100;
+    float radius = 0.10f;
+    float radiusShrink = 0.95f;
+    float minRadius = 0.03f;
+    float speed = 500.0f;
+    float speedStep = 0.20f;
+    float gravity = 600.0f;
+    std::string effect;
+    int effectLine = 0;
+};
+
+// One key of a [rounds A-B] section, applied after the curve
+struct RoundOverride {
+    int first;
+    int last; // 0 = through the last record
+    std::string key;
+    std::string value;
+    int line;
+};
+
+struct NamedEffect {
+    std::string name;
+    EffectDef def;
+    int sizeLine;   // where size was set, or the section header
+};
+
+// Short side of the largest screen (4K UHD) on which particle sizes must
+// still fit a packed particle
+const float kLargestScreenSide = 2160.0f;
+
+struct Source {
+    Curve curve;
+    std::vector<RoundOverride> overrides;
+    std::vector<NamedEffect> effects;
+};
+
+class ParseError {
+public:
+    ParseError(int line, const std::string& message) : line(line), message(message) {}
+    int line;
+    std::string message;
+};
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+float parseNumber(const std::string& text, int line) {
+    char* end = nullptr;
+    float value = strtof(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !std::isfinite(value)) {
+        throw ParseError(line, "expected a number, got '" + text + "'");
+    }
+    return value;
+}
+
+int parseInt(const std::string& text, int line) {
+    float value = parseNumber(text, line);
+    if (value != std::floor(value)) {
+        throw ParseError(line, "expected a whole number, got '" + text + "'");
+    }
+    return static_cast<int>(value);
+}
+
+// "A-B" or a single value "A" (min = max)
+void parseRange(const std::string& text, int line, float* min, float* max) {
+    size_t dash = text.find('-', 1);
+    if (dash == std::string::npos) {
+        *min = *max = parseNumber(text, line);
+    } else {
+        *min = parseNumber(trim(text.substr(0, dash)), line);
+        *max = parseNumber(trim(text.substr(dash + 1)), line);
+    }
+    if (*max < *min) {
+        throw ParseError(line, "range '" + text + "' is reversed");
+    }
+}
+
+void parseEffectKey(EffectDef& def, const std::string& key, const std::string& value, int line) {
+    float min;
+    float max;
+    if (key == "particles") {
+        parseRange(value, line, &min, &max);
+        if (min < 0.0f || max > 65535.0f || min != std::floor(min) || max != std::floor(max)) {
+            throw ParseError(line, "particles must be whole numbers in 0-65535");
+        }
+        def.particlesMin = static_cast<uint16_t>(min);
+        def.particlesMax = static_cast<uint16_t>(max);
+    } else if (key == "speed") {
+        parseRange(value, line, &def.speedMin, &def.speedMax);
+    } else if (key == "upward_bias") {
+        def.upwardBias = parseNumber(value, line);
+    } else if (key == "size") {
+        parseRange(value, line, &def.sizeMin, &def.sizeMax);
+    } else if (key == "color_jitter") {
+        def.colorJitter = parseNumber(value, line);
+    } else if (key == "lifetime") {
+        parseRange(value, line, &def.lifetimeMin, &def.lifetimeMax);
+        if (def.lifetimeMin <= 0.0f) {
+            throw ParseError(line, "lifetime must be positive");
+        }
+        if (def.lifetimeMax > PACKED_MAX_LIFETIME) {
+            char message[96];
+            snprintf(message, sizeof(message), "lifetime must be at most %.2f s (packed particle limit)",
+                     PACKED_MAX_LIFETIME);
+            throw ParseError(line, message);
+        }
+    } else {
+        throw ParseError(line, "unknown effect key '" + key + "'");
+    }
+}
+
+void parseCurveKey(Curve& curve, const std::string& key, const std::string& value, int line) {
+    if (key == "rounds") {
+        curve.rounds = parseInt(value, line);
+        if (curve.rounds < 1 || curve.rounds > 10000) {
+            throw ParseError(line, "rounds must be in 1-10000");
+        }
+    } else if (key == "radius") {
+        curve.radius = parseNumber(value, line);
+    } else if (key == "radius_shrink") {
+        curve.radiusShrink = parseNumber(value, line);
+    } else if (key == "min_radius") {
+        curve.minRadius = parseNumber(value, line);
+    } else if (key == "speed") {
+        curve.speed = parseNumber(value, line);
+    } else if (key == "speed_step") {
+        curve.speedStep = parseNumber(value, line);
+    } else if (key == "gravity") {
+        curve.gravity = parseNumber(value, line);
+    } else if (key == "effect") {
+        curve.effect = value;
+        curve.effectLine = line;
+    } else {
+        throw ParseError(line, "unknown curve key '" + key + "'");
+    }
+}
+
+Source parse(std::istream& input) {
+    Source source;
+    enum { NONE, CURVE, ROUNDS, EFFECT } section = NONE;
+    int first = 0;
+    int last = 0;
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(input, line)) {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (line.back() != ']') throw ParseError(lineNumber, "unterminated section header");
+            std::istringstream header(line.substr(1, line.size() - 2));
+            std::string kind;
+            std::string argument;
+            std::string extra;
+            header >> kind >> argument >> extra;
+            if (!extra.empty()) throw ParseError(lineNumber, "unexpected '" + extra + "'");
+
+            if (kind == "curve" && argument.empty()) {
+                section = CURVE;
+            } else if (kind == "rounds" && !argument.empty()) {
+                section = ROUNDS;
+                size_t dash = argument.find('-');
+                first = parseInt(argument.substr(0, dash), lineNumber);
+                last = dash == std::string::npos ? first
+                     : dash + 1 == argument.size() ? 0
+                     : parseInt(argument.substr(dash + 1), lineNumber);
+                if (first < 1 || (last != 0 && last < first)) {
+                    throw ParseError(lineNumber, "bad round range '" + argument + "'");
+                }
+            } else if (kind == "effect" && !argument.empty()) {
+                section = EFFECT;
+                for (const NamedEffect& effect : source.effects) {
+                    if (effect.name == argument) throw ParseError(lineNumber, "effect '" + argument + "' redefined");
+                }
+                NamedEffect effect;
+                effect.name = argument;
+                effect.def = EffectDef{20, 30, 200.0f, 600.0f, 200.0f, 0.15f, 0.25f, 0.2f, 0.5f, 1.0f, {0, 0, 0}};
+                effect.sizeLine = lineNumber;
+                source.effects.push_back(effect);
+            } else {
+                throw ParseError(lineNumber, "unknown section '" + line + "'");
+            }
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) throw ParseError(lineNumber, "expected key = value");
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+
+        switch (section) {
+            case CURVE:
+                parseCurveKey(source.curve, key, value, lineNumber);
+                break;
+            case ROUNDS:
+                if (key != "radius" && key != "speed" && key != "circles" && key != "effect") {
+                    throw ParseError(lineNumber, "unknown round key '" + key + "'");
+                }
+                source.overrides.push_back(RoundOverride{first, last, key, value, lineNumber});
+                break;
+            case EFFECT:
+                parseEffectKey(source.effects.back().def, key, value, lineNumber);
+                if (key == "size") source.effects.back().sizeLine = lineNumber;
+                break;
+            case NONE:
+                throw ParseError(lineNumber, "key outside of a section");
+        }
+    }
+
+    if (source.effects.empty()) throw ParseError(lineNumber, "no [effect] section");
+    return source;
+}
+
+uint16_t findEffect(const Source& source, const std::string& name, int line) {
+    for (size_t i = 0; i < source.effects.size(); i++) {
+        if (source.effects[i].name == name) return static_cast<uint16_t>(i);
+    }
+    throw ParseError(line, "unknown effect '" + name + "'");
+}
+
+void applyOverride(const Source& source, const RoundOverride& change, int roundNumber, RoundDef& def) {
+    if (change.key == "radius") {
+        def.radius = parseNumber(change.value, change.line);
+    } else if (change.key == "speed") {
+        def.speed = parseNumber(change.value, change.line);
+    } else if (change.key == "effect") {
+        def.effect = findEffect(source, change.value, change.line);
+    } else if (change.value == "round") {
+        def.circlesMin = def.circlesMax = static_cast<uint16_t>(std::min(roundNumber, 65535));
+    } else {
+        float min;
+        float max;
+        parseRange(change.value, change.line, &min, &max);
+        if (min < 1.0f || max > 65535.0f || min != std::floor(min) || max != std::floor(max)) {
+            throw ParseError(change.line, "circles must be whole numbers in 1-65535");
+        }
+        def.circlesMin = static_cast<uint16_t>(min);
+        def.circlesMax = static_cast<uint16_t>(max);
+    }
+}
+
+size_t alignRecords(size_t offset) {
+    return (offset + LevelTable::RECORD_ALIGNMENT - 1) / LevelTable::RECORD_ALIGNMENT * LevelTable::RECORD_ALIGNMENT;
+}
+
+std::vector<uint8_t> build(const Source& source) {
+    const Curve& curve = source.curve;
+    uint16_t defaultEffect = curve.effect.empty() ? 0 : findEffect(source, curve.effect, curve.effectLine);
+
+    std::vector<RoundDef> rounds(curve.rounds);
+    for (int i = 0; i < curve.rounds; i++) {
+        RoundDef& def = rounds[i];
+        def.radius = std::max(curve.radius * powf(curve.radiusShrink, static_cast<float>(i)), curve.minRadius);
+        def.speed = curve.speed * (1.0f + i * curve.speedStep);
+        def.circlesMin = 1;
+        def.circlesMax = 1;
+        def.effect = defaultEffect;
+        def.reserved = 0;
+    }
+    for (const RoundOverride& change : source.overrides) {
+        int last = change.last == 0 ? curve.rounds : std::min(change.last, curve.rounds);
+        for (int r = change.first; r <= last; r++) {
+            applyOverride(source, change, r, rounds[r - 1]);
+        }
+    }
+
+    // The largest particle of each round's effect, on the largest screen
+    for (int i = 0; i < curve.rounds; i++) {
+        const NamedEffect& effect = source.effects[rounds[i].effect];
+        float size = kLargestScreenSide * rounds[i].radius * effect.def.sizeMax;
+        if (size > PACKED_MAX_SIZE) {
+            char message[160];
+            snprintf(message, sizeof(message),
+                     "size of effect '%s' reaches %.1f px in round %d on a %.0f px screen side; "
+                     "packed particles hold at most %.1f px", effect.name.c_str(), size, i + 1,
+                     kLargestScreenSide, PACKED_MAX_SIZE);
+            throw ParseError(effect.sizeLine, message);
+        }
+    }
+
+    size_t roundsOffset = alignRecords(sizeof(LevelTableHeader));
+    size_t effectsOffset = alignRecords(roundsOffset + rounds.size() * sizeof(RoundDef));
+    size_t fileSize = effectsOffset + source.effects.size() * sizeof(EffectDef);
+
+    LevelTableHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "TGLEVELS", sizeof(header.magic));
+    header.version = LevelTable::VERSION;
+    header.fileSize = static_cast<uint32_t>(fileSize);
+    header.roundCount = static_cast<uint32_t>(rounds.size());
+    header.roundsOffset = static_cast<uint32_t>(roundsOffset);
+    header.effectCount = static_cast<uint32_t>(source.effects.size());
+    header.effectsOffset = static_cast<uint32_t>(effectsOffset);
+    header.tailSpeedStep = curve.speed * curve.speedStep;
+    header.gravity = curve.gravity;
+
+    std::vector<uint8_t> image(fileSize, 0);
+    memcpy(image.data(), &header, sizeof(header));
+    memcpy(image.data() + roundsOffset, rounds.data(), rounds.size() * sizeof(RoundDef));
+    for (size_t i = 0; i < source.effects.size(); i++) {
+        memcpy(image.data() + effectsOffset + i * sizeof(EffectDef), &source.effects[i].def, sizeof(EffectDef));
+    }
+    return image;
+}
+
+int dump(const char* path) {
+    LevelTable table;
+    if (!table.mapFile(path)) {
+        fprintf(stderr, "%s: not a valid level table\n", path);
+        return 1;
+    }
+    printf("%d rounds, %d effects, gravity %.1f\n", table.getRoundCount(), table.getEffectCount(),
+           table.getGravity());
+    printf("round  radius   speed  circles  effect\n");
+    for (int r = 1; r <= table.getRoundCount(); r++) {
+        const RoundDef& def = table.round(r);
+        printf("%5d  %6.4f  %6.1f  %3d-%-3d  %6d\n", r, def.radius, def.speed, def.circlesMin, def.circlesMax,
+               def.effect);
+    }
+    printf("then +%.1f px/s per round\n", table.speedForRound(table.getRoundCount() + 1) -
+                                           table.speedForRound(table.getRoundCount()));
+    for (int i = 0; i < table.getEffectCount(); i++) {
+        const EffectDef& def = table.effect(static_cast<uint16_t>(i));
+        printf("effect %d: %d-%d particles, speed %.0f-%.0f, bias %.0f, size %.2f-%.2f, jitter %.2f, "
+               "lifetime %.2f-%.2f\n", i, def.particlesMin, def.particlesMax, def.speedMin, def.speedMax,
+               def.upwardBias, def.sizeMin, def.sizeMax, def.colorJitter, def.lifetimeMin, def.lifetimeMax);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && strcmp(argv[1], "--dump") == 0) {
+        return dump(argv[2]);
+    }
+    if (argc != 3) {
+        fprintf(stderr, "usage: touchgame_levelc SOURCE OUTPUT\n"
+                        "       touchgame_levelc --dump TABLE\n");
+        return 1;
+    }
+
+    const char* sourcePath = argv[1];
+    const char* outputPath = argv[2];
+    std::ifstream input(sourcePath);
+    if (!input) {
+        fprintf(stderr, "cannot read %s\n", sourcePath);
+        return 1;
+    }
+
+    std::vector<uint8_t> image;
+    try {
+        image = build(parse(input));
+    } catch (const ParseError& error) {
+        fprintf(stderr, "%s:%d: %s\n", sourcePath, error.line, error.message.c_str());
+        return 1;
+    }
+
+    LevelTable check;
+    if (!check.attach(image.data(), image.size())) {
+        fprintf(stderr, "%s: values out of range (radius must be in (0, 0.5))\n", sourcePath);
+        return 1;
+    }
+
+    FILE* output = fopen(outputPath, "wb");
+    if (output == nullptr || fwrite(image.data(), 1, image.size(), output) != image.size()) {
+        fprintf(stderr, "cannot write %s\n", outputPath);
+        if (output) fclose(output);
+        return 1;
+    }
+    fclose(output);
+    return 0;
+}
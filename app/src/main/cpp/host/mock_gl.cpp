@@ -0,0 +1,270 @@
+#include "host/mock_gl.h"
+#include <EGL/egl.h>
+#include <GLES2/gl2.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace {
+
+struct Counter {
+    const char* name;
+    uint64_t calls;
+
+    explicit Counter(const char* function);
+};
+
+std::vector<Counter*>& counters() {
+    static std::vector<Counter*> list;
+    return list;
+}
+
+Counter::Counter(const char* function) : name(function), calls(0) {
+    counters().push_back(this);
+}
+
+// Entry points register on their first call
+#define MOCK_CALL() \
+    static Counter counter(__func__); \
+    counter.calls++
+
+struct MockSurface {
+    EGLint width;
+    EGLint height;
+};
+
+GLuint nextName = 1;
+
+// Locations are handed out per program in order of first query
+std::map<GLuint, std::map<std::string, GLint>> attribLocations;
+std::map<GLuint, std::map<std::string, GLint>> uniformLocations;
+
+GLint locationFor(std::map<std::string, GLint>& locations, const GLchar* name) {
+    auto found = locations.find(name);
+    if (found != locations.end()) return found->second;
+    GLint location = static_cast<GLint>(locations.size());
+    locations[name] = location;
+    return location;
+}
+
+void generate(GLsizei n, GLuint* names) {
+    for (GLsizei i = 0; i < n; i++) {
+        names[i] = nextName++;
+    }
+}
+
+} // namespace
+
+namespace mockgl {
+
+uint64_t calls(const char* function) {
+    for (const Counter* counter : counters()) {
+        if (strcmp(counter->name, function) == 0) return counter->calls;
+    }
+    return 0;
+}
+
+void reset() {
+    for (Counter* counter : counters()) {
+        counter->calls = 0;
+    }
+}
+
+std::string report() {
+    std::vector<const Counter*> sorted(counters().begin(), counters().end());
+    std::sort(sorted.begin(), sorted.end(), [](const Counter* a, const Counter* b) {
+        return strcmp(a->name, b->name) < 0;
+    });
+
+    std::string result;
+    char line[96];
+    for (const Counter* counter : sorted) {
+        if (counter->calls == 0) continue;
+        snprintf(line, sizeof(line), "%-28s %10llu\n", counter->name, (unsigned long long)counter->calls);
+        result += line;
+    }
+    return result;
+}
+
+} // namespace mockgl
+
+// EGL: one display, one config, one context; pbuffers remember their size
+
+extern "C" {
+
+EGLDisplay eglGetDisplay(EGLNativeDisplayType) {
+    MOCK_CALL();
+    return reinterpret_cast<EGLDisplay>(1);
+}
+
+EGLBoolean eglInitialize(EGLDisplay, EGLint* major, EGLint* minor) {
+    MOCK_CALL();
+    if (major) *major = 1;
+    if (minor) *minor = 4;
+    return EGL_TRUE;
+}
+
+EGLBoolean eglTerminate(EGLDisplay) {
+    MOCK_CALL();
+    return EGL_TRUE;
+}
+
+const char* eglQueryString(EGLDisplay, EGLint) {
+    MOCK_CALL();
+    return "";
+}
+
+__eglMustCastToProperFunctionPointerType eglGetProcAddress(const char*) {
+    MOCK_CALL();
+    return nullptr;
+}
+
+EGLBoolean eglChooseConfig(EGLDisplay, const EGLint*, EGLConfig* configs, EGLint size, EGLint* count) {
+    MOCK_CALL();
+    if (configs && size > 0) configs[0] = reinterpret_cast<EGLConfig>(1);
+    *count = 1;
+    return EGL_TRUE;
+}
+
+EGLContext eglCreateContext(EGLDisplay, EGLConfig, EGLContext, const EGLint*) {
+    MOCK_CALL();
+    return reinterpret_cast<EGLContext>(1);
+}
+
+EGLBoolean eglDestroyContext(EGLDisplay, EGLContext) {
+    MOCK_CALL();
+    return EGL_TRUE;
+}
+
+EGLSurface eglCreatePbufferSurface(EGLDisplay, EGLConfig, const EGLint* attribs) {
+    MOCK_CALL();
+    MockSurface* surface = new MockSurface{0, 0};
+    for (const EGLint* attrib = attribs; attrib && attrib[0] != EGL_NONE; attrib += 2) {
+        if (attrib[0] == EGL_WIDTH) surface->width = attrib[1];
+        if (attrib[0] == EGL_HEIGHT) surface->height = attrib[1];
+    }
+    return surface;
+}
+
+EGLBoolean eglDestroySurface(EGLDisplay, EGLSurface surface) {
+    MOCK_CALL();
+    delete static_cast<MockSurface*>(surface);
+    return EGL_TRUE;
+}
+
+EGLBoolean eglQuerySurface(EGLDisplay, EGLSurface surface, EGLint attribute, EGLint* value) {
+    MOCK_CALL();
+    const MockSurface* mock = static_cast<const MockSurface*>(surface);
+    if (mock == nullptr) return EGL_FALSE;
+    if (attribute == EGL_WIDTH) *value = mock->width;
+    if (attribute == EGL_HEIGHT) *value = mock->height;
+    return EGL_TRUE;
+}
+
+EGLBoolean eglSurfaceAttrib(EGLDisplay, EGLSurface, EGLint, EGLint) {
+    MOCK_CALL();
+    return EGL_TRUE;
+}
+
+EGLBoolean eglMakeCurrent(EGLDisplay, EGLSurface, EGLSurface, EGLContext) {
+    MOCK_CALL();
+    return EGL_TRUE;
+}
+
+EGLBoolean eglReleaseThread() {
+    MOCK_CALL();
+    return EGL_TRUE;
+}
+
+EGLBoolean eglSwapBuffers(EGLDisplay, EGLSurface) {
+    MOCK_CALL();
+    return EGL_TRUE;
+}
+
+// GLES2: object creation hands out increasing names; everything else only
+// counts
+
+GLuint glCreateShader(GLenum) {
+    MOCK_CALL();
+    return nextName++;
+}
+
+void glShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) { MOCK_CALL(); }
+void glCompileShader(GLuint) { MOCK_CALL(); }
+void glDeleteShader(GLuint) { MOCK_CALL(); }
+
+GLuint glCreateProgram() {
+    MOCK_CALL();
+    return nextName++;
+}
+
+void glAttachShader(GLuint, GLuint) { MOCK_CALL(); }
+void glLinkProgram(GLuint) { MOCK_CALL(); }
+
+void glDeleteProgram(GLuint program) {
+    MOCK_CALL();
+    attribLocations.erase(program);
+    uniformLocations.erase(program);
+}
+
+GLint glGetAttribLocation(GLuint program, const GLchar* name) {
+    MOCK_CALL();
+    return locationFor(attribLocations[program], name);
+}
+
+GLint glGetUniformLocation(GLuint program, const GLchar* name) {
+    MOCK_CALL();
+    return locationFor(uniformLocations[program], name);
+}
+
+void glUseProgram(GLuint) { MOCK_CALL(); }
+
+void glGenBuffers(GLsizei n, GLuint* buffers) {
+    MOCK_CALL();
+    generate(n, buffers);
+}
+
+void glDeleteBuffers(GLsizei, const GLuint*) { MOCK_CALL(); }
+void glBindBuffer(GLenum, GLuint) { MOCK_CALL(); }
+void glBufferData(GLenum, GLsizeiptr, const void*, GLenum) { MOCK_CALL(); }
+void glBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) { MOCK_CALL(); }
+
+void glGenTextures(GLsizei n, GLuint* textures) {
+    MOCK_CALL();
+    generate(n, textures);
+}
+
+void glDeleteTextures(GLsizei, const GLuint*) { MOCK_CALL(); }
+void glActiveTexture(GLenum) { MOCK_CALL(); }
+void glBindTexture(GLenum, GLuint) { MOCK_CALL(); }
+void glPixelStorei(GLenum, GLint) { MOCK_CALL(); }
+void glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) { MOCK_CALL(); }
+void glTexParameteri(GLenum, GLenum, GLint) { MOCK_CALL(); }
+
+void glEnableVertexAttribArray(GLuint) { MOCK_CALL(); }
+void glDisableVertexAttribArray(GLuint) { MOCK_CALL(); }
+void glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { MOCK_CALL(); }
+
+void glUniform1i(GLint, GLint) { MOCK_CALL(); }
+void glUniform1f(GLint, GLfloat) { MOCK_CALL(); }
+void glUniform2f(GLint, GLfloat, GLfloat) { MOCK_CALL(); }
+void glUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) { MOCK_CALL(); }
+void glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) { MOCK_CALL(); }
+
+void glEnable(GLenum) { MOCK_CALL(); }
+void glDisable(GLenum) { MOCK_CALL(); }
+void glBlendFunc(GLenum, GLenum) { MOCK_CALL(); }
+void glViewport(GLint, GLint, GLsizei, GLsizei) { MOCK_CALL(); }
+void glClear(GLbitfield) { MOCK_CALL(); }
+void glDrawArrays(GLenum, GLint, GLsizei) { MOCK_CALL(); }
+void glFinish() { MOCK_CALL(); }
+
+void glGetIntegerv(GLenum name, GLint* data) {
+    MOCK_CALL();
+    // The GLES2 minimum, so code relying on more shows up on the host
+    if (name == GL_MAX_VERTEX_ATTRIBS) *data = 8;
+}
+
+} // extern "C"
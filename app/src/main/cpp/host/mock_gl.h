@@ -0,0 +1,22 @@
+#ifndef TOUCHGAME_MOCK_GL_H
+#define TOUCHGAME_MOCK_GL_H
+
+#include <cstdint>
+#include <string>
+
+// Recording stand-in for libEGL and libGLESv2 (host/mock_gl.cpp). Linked
+// instead of the real libraries, every entry point the GLES2 renderer uses
+// just counts its calls and hands out fake names and locations, so the
+// exact GL traffic of a frame can be inspected on any Linux box: no GPU,
+// driver or display needed. Nothing is drawn.
+namespace mockgl {
+
+// Calls of one entry point since the last reset(), e.g. calls("glUseProgram")
+uint64_t calls(const char* function);
+void reset();
+// One "name count" line per entry point called since the last reset()
+std::string report();
+
+} // namespace mockgl
+
+#endif // TOUCHGAME_MOCK_GL_H
@@ -0,0 +1,556 @@
+// touchgame_render_bench: offscreen renderer benchmark.
+//
+//   touchgame_render_bench --balls 1000 --particles 20000
+//   touchgame_render_bench --sweep --frames 120
+//   touchgame_render_bench --game 12 --frames 3600
+//   touchgame_render_bench --particle-sweep --frames 30
+//
+// Draws a synthetic scene (bouncing balls, falling particles, the HUD)
+// through a RenderBackend with no window (an EGL pbuffer for gles2) and
+// reports the CPU cost of recording and submitting a frame and the overall
+// frame rate including GPU time.
+// --sweep runs both ball styles (tessellated mesh, per-fragment impostor)
+// over a grid of ball counts and radii and prints one line per run.
+// --game ROUND plays the real game from that round instead, driven by the
+// autoplayer, and times whole frames (bot, simulation and submission).
+//
+// Particles come from explosions of --explosion particles each, topped up
+// to --particles live, in any particle mode: cpu integrates and uploads
+// every particle, packed does the same on 16-byte quantized particles that
+// are uploaded as they are, gpu keeps one spawn record per explosion and
+// evaluates the particles in the vertex shader. --particle-sweep compares
+// the modes at 10k-1M particles; the update column is the per-frame
+// simulation cost.
+//
+// touchgame_render_bench_mockgl is the same program linked against
+// host/mock_gl.cpp instead of EGL/GLES2: frame rates are meaningless there,
+// but it prints the exact GL calls the measured frames made next to the
+// renderer's own issued/elided counters.
+
+#include "autoplayer.h"
+#include "game.h"
+#include "hud.h"
+#include "packed_entities.h"
+#include "particles.h"
+#include "render_backend.h"
+#ifdef TOUCHGAME_MOCK_GL
+#include "host/mock_gl.h"
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static void usage() {
+    std::string names;
+    for (const std::string& name : availableRenderBackends()) {
+        names += names.empty() ? name : " | " + name;
+    }
+    fprintf(stderr,
+        "usage: touchgame_render_bench [options]\n"
+        "  --backend B        %s (default gles2)\n"
+        "  --size WxH         framebuffer size in pixels (default 1080x1920)\n"
+        "  --balls N          balls on screen (default 10)\n"
+        "  --radius PX        ball radius (default 5%% of the shorter side)\n"
+        "  --ball-style S     mesh | impostor (default mesh)\n"
+        "  --particles N      live particles (default 100)\n"
+        "  --explosion N      particles per explosion (default 25, 1000 for\n"
+        "                     --particle-sweep)\n"
+        "  --particle-mode M  cpu | packed | gpu (default cpu)\n"
+        "  --frames N         measured frames (default 600)\n"
+        "  --warmup N         unmeasured frames first (default 60)\n"
+        "  --sweep            both ball styles at 1-1000 balls and 2-15%% radius\n"
+        "  --particle-sweep   every particle mode at 10k-1M particles\n"
+        "  --game ROUND       autoplay the real game from ROUND instead of the\n"
+        "                     synthetic scene (--balls/--radius/--particles unused)\n"
+        "  --seed N           game and autoplayer seed for --game (default 1)\n",
+        names.c_str());
+}
+
+static double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+    return values[index];
+}
+
+struct BenchOptions {
+    int width;
+    int height;
+    int ballCount;
+    float radius;
+    int particleCount;
+    int explosionSize;
+    ParticleMode particleMode;
+    int frameCount;
+    int warmupCount;
+};
+
+struct BenchResult {
+    double updateMean;       // scene simulation, ms
+    double cpuMean;          // drawFrame + present, ms
+    double cpuP50;
+    double cpuP99;
+    double framesPerSecond;
+};
+
+static BenchResult summarize(const std::vector<double>& cpuMs, double wallSeconds) {
+    double cpuTotal = 0.0;
+    for (double ms : cpuMs) cpuTotal += ms;
+
+    BenchResult result;
+    result.updateMean = 0.0;
+    result.cpuMean = cpuTotal / cpuMs.size();
+    result.cpuP50 = percentile(cpuMs, 0.5);
+    result.cpuP99 = percentile(cpuMs, 0.99);
+    result.framesPerSecond = cpuMs.size() / wallSeconds;
+    return result;
+}
+
+// Explosions with the shape of the level table's default effect, kept at
+// a steady particle count in either mode
+class ParticleScene {
+public:
+    ParticleScene(const BenchOptions& options)
+        : mode(options.particleMode), target(options.particleCount),
+          explosionSize(std::max(options.explosionSize, 1)), width(options.width), height(options.height),
+          baseSize(options.radius * 0.2f), time(0.0f), live(0), rng(2), unit(0.0f, 1.0f) {
+        // Start with ages spread over a lifetime, as in steady state
+        while (live < target && !full()) {
+            explode(unit(rng) * 0.5f);
+        }
+    }
+
+    void update(float dt) {
+        time += dt;
+        if (mode == PARTICLE_MODE_GPU) {
+            spawns.retire(time);
+            live = 0;
+            for (size_t i = 0; i < spawns.size(); i++) {
+                if (time - spawns[i].spawnTime < spawns[i].lifetimeMax) live += spawns[i].count;
+            }
+        } else if (mode == PARTICLE_MODE_PACKED) {
+            updatePackedParticles(packedParticles, dt, GRAVITY, height);
+            live = static_cast<int>(packedParticles.size());
+        } else {
+            updateParticles(particles, dt, GRAVITY);
+            live = static_cast<int>(particles.size());
+        }
+        while (live < target && !full()) {
+            explode(0.0f);
+        }
+    }
+
+    void fill(FrameData& frame) const {
+        frame.particles = &particles;
+        frame.packedParticles = &packedParticles;
+        frame.particleSpawns = &spawns;
+        frame.particleTime = time;
+    }
+
+private:
+    static constexpr float GRAVITY = 600.0f;
+
+    // More explosions than the ring holds would only replace live ones
+    bool full() const {
+        return mode == PARTICLE_MODE_GPU && spawns.size() >= ParticleSpawnRing::MAX_CAPACITY;
+    }
+
+    void explode(float age) {
+        float x = unit(rng) * width;
+        float y = unit(rng) * height * 0.8f;
+        float r = unit(rng);
+        float g = unit(rng);
+        float b = unit(rng);
+        if (mode == PARTICLE_MODE_GPU) {
+            ParticleSpawn& spawn = spawns.spawn();
+            spawn.x = x;
+            spawn.y = y;
+            spawn.spawnTime = time - age;
+            spawn.seed = static_cast<float>(rng() & 0xFFFF);
+            spawn.colorR = r;
+            spawn.colorG = g;
+            spawn.colorB = b;
+            spawn.colorJitter = 0.2f;
+            spawn.sizeMin = baseSize * 0.75f;
+            spawn.sizeMax = baseSize * 1.25f;
+            spawn.speedMin = 200.0f;
+            spawn.speedMax = 600.0f;
+            spawn.upwardBias = 200.0f;
+            spawn.gravity = GRAVITY;
+            spawn.lifetimeMin = 0.5f;
+            spawn.lifetimeMax = 1.0f;
+            spawn.count = static_cast<uint32_t>(explosionSize);
+        } else {
+            for (int i = 0; i < explosionSize; i++) {
+                Particle particle;
+                float angle = unit(rng) * 2.0f * static_cast<float>(M_PI);
+                float speed = 200.0f + unit(rng) * 400.0f;
+                particle.velocityX = cosf(angle) * speed;
+                particle.velocityY = sinf(angle) * speed - 200.0f + GRAVITY * age;
+                particle.x = x + particle.velocityX * age;
+                particle.y = y + particle.velocityY * age;
+                particle.size = baseSize * (0.75f + unit(rng) * 0.5f);
+                particle.colorR = std::min(1.0f, r + (unit(rng) - 0.5f) * 0.2f);
+                particle.colorG = std::min(1.0f, g + (unit(rng) - 0.5f) * 0.2f);
+                particle.colorB = std::min(1.0f, b + (unit(rng) - 0.5f) * 0.2f);
+                particle.lifetime = age;
+                particle.maxLifetime = 0.5f + unit(rng) * 0.5f;
+                if (mode == PARTICLE_MODE_PACKED) {
+                    packedParticles.push_back(packParticle(particle, width, height));
+                } else {
+                    particles.push_back(particle);
+                }
+            }
+        }
+        live += explosionSize;
+    }
+
+    ParticleMode mode;
+    int target;
+    int explosionSize;
+    int width;
+    int height;
+    float baseSize;
+    float time;
+    int live;
+    std::vector<Particle> particles;
+    std::vector<PackedParticle> packedParticles;
+    ParticleSpawnRing spawns;
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> unit;
+};
+
+static BenchResult runBench(RenderBackend& backend, const BenchOptions& options) {
+    const int width = options.width;
+    const int height = options.height;
+
+    // Synthetic scene with the game's proportions
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float radius = options.radius;
+
+    std::vector<Circle> circles(options.ballCount);
+    for (Circle& circle : circles) {
+        float angle = unit(rng) * 2.0f * static_cast<float>(M_PI);
+        circle.x = radius + unit(rng) * (width - 2.0f * radius);
+        circle.y = radius + unit(rng) * (height - 2.0f * radius);
+        circle.radius = radius;
+        circle.velocityX = cosf(angle) * 500.0f;
+        circle.velocityY = sinf(angle) * 500.0f;
+        circle.colorR = unit(rng) * 0.4f;
+        circle.colorG = unit(rng) * 0.4f;
+        circle.colorB = unit(rng) * 0.4f;
+        circle.flashTimer = 0.0f;
+    }
+
+    ParticleScene particles(options);
+
+    Hud hud;
+    hud.init(width, height);
+
+    FrameData frame;
+    frame.screenWidth = width;
+    frame.screenHeight = height;
+    frame.bgColor1[0] = 0.9f;
+    frame.bgColor1[1] = 0.9f;
+    frame.bgColor1[2] = 1.0f;
+    frame.bgColor2[0] = 1.0f;
+    frame.bgColor2[1] = 0.9f;
+    frame.bgColor2[2] = 0.9f;
+    frame.circles = &circles;
+    frame.hud = &hud;
+
+    const float dt = 1.0f / 60.0f;
+    std::vector<double> cpuMs;
+    cpuMs.reserve(options.frameCount);
+    double updateTotal = 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < options.warmupCount + options.frameCount; f++) {
+        if (f == options.warmupCount) {
+            backend.finish();
+            backend.resetStats();
+#ifdef TOUCHGAME_MOCK_GL
+            mockgl::reset();
+#endif
+            start = std::chrono::steady_clock::now();
+        }
+
+        auto updateStart = std::chrono::steady_clock::now();
+        for (Circle& circle : circles) {
+            circle.x += circle.velocityX * dt;
+            circle.y += circle.velocityY * dt;
+            if (circle.x < circle.radius || circle.x > width - circle.radius) circle.velocityX = -circle.velocityX;
+            if (circle.y < circle.radius || circle.y > height - circle.radius) circle.velocityY = -circle.velocityY;
+        }
+        particles.update(dt);
+        particles.fill(frame);
+        hud.setValues(f / 10, 1 + f / 600, true);
+
+        auto frameStart = std::chrono::steady_clock::now();
+        backend.drawFrame(frame);
+        backend.present();
+        auto frameEnd = std::chrono::steady_clock::now();
+
+        if (f >= options.warmupCount) {
+            updateTotal += std::chrono::duration<double, std::milli>(frameStart - updateStart).count();
+            cpuMs.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+        }
+    }
+    backend.finish();
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    BenchResult result = summarize(cpuMs, wallSeconds);
+    result.updateMean = updateTotal / options.frameCount;
+    return result;
+}
+
+// The game itself from `round` on, the autoplayer tapping as a player
+// would; rounds advance as it clears them. Fixed 60 Hz ticks and seeds, so
+// every run does identical work.
+static BenchResult runGameBench(RenderBackend& backend, const BenchOptions& options, int round,
+                                uint32_t seed, int* endRound, int* endScore) {
+    Game game(seed);
+    game.setParticleMode(options.particleMode);
+    game.init(options.width, options.height);
+    game.startRound(round);
+    Autoplayer autoplayer;
+    autoplayer.reset(seed);
+
+    const float dt = 1.0f / 60.0f;
+    std::vector<double> cpuMs;
+    cpuMs.reserve(options.frameCount);
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < options.warmupCount + options.frameCount; f++) {
+        if (f == options.warmupCount) {
+            backend.finish();
+            backend.resetStats();
+#ifdef TOUCHGAME_MOCK_GL
+            mockgl::reset();
+#endif
+            start = std::chrono::steady_clock::now();
+        }
+
+        auto frameStart = std::chrono::steady_clock::now();
+        float x, y;
+        if (autoplayer.update(game, (f + 1) * dt, x, y)) {
+            game.handleTouch(x, y);
+        }
+        game.update(dt);
+        game.render(backend);
+        backend.present();
+        auto frameEnd = std::chrono::steady_clock::now();
+
+        if (f >= options.warmupCount) {
+            cpuMs.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+        }
+    }
+    backend.finish();
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    *endRound = game.getRound();
+    *endScore = game.getScore();
+    return summarize(cpuMs, wallSeconds);
+}
+
+// Both ball styles over a grid of counts and radii (fractions of the
+// shorter side): the mesh costs vertices per ball, the impostor pixels
+static int runSweep(RenderBackend& backend, BenchOptions options) {
+    static const int kBallCounts[] = {1, 10, 100, 1000};
+    static const float kRadii[] = {0.02f, 0.05f, 0.15f};
+    static const BallStyle kStyles[] = {BALL_STYLE_MESH, BALL_STYLE_IMPOSTOR};
+
+    printf("%s %dx%d, %d particles, %d frames per run\n", backend.getName(), options.width,
+           options.height, options.particleCount, options.frameCount);
+    printf("%-9s %6s %8s %10s %10s %10s %10s\n", "style", "balls", "radius", "cpu mean", "cpu p50",
+           "cpu p99", "frames/s");
+    for (BallStyle style : kStyles) {
+        if (!backend.setBallStyle(style)) {
+            printf("%-9s not supported by %s\n", ballStyleName(style), backend.getName());
+            continue;
+        }
+        for (int ballCount : kBallCounts) {
+            for (float fraction : kRadii) {
+                options.ballCount = ballCount;
+                options.radius = std::min(options.width, options.height) * fraction;
+                BenchResult result = runBench(backend, options);
+                printf("%-9s %6d %8.0f %10.3f %10.3f %10.3f %10.1f\n", ballStyleName(style), ballCount,
+                       options.radius, result.cpuMean, result.cpuP50, result.cpuP99,
+                       result.framesPerSecond);
+                fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
+
+// Particle modes at growing counts: the cpu and packed modes' update and
+// submit cost scale with particles, the gpu mode's with explosions
+static int runParticleSweep(RenderBackend& backend, BenchOptions options) {
+    static const int kParticleCounts[] = {10000, 100000, 1000000};
+    static const ParticleMode kModes[] = {PARTICLE_MODE_CPU, PARTICLE_MODE_PACKED, PARTICLE_MODE_GPU};
+
+    printf("%s %dx%d, %d %s balls, %d particles per explosion, %d frames per run\n", backend.getName(),
+           options.width, options.height, options.ballCount, ballStyleName(backend.getBallStyle()),
+           options.explosionSize, options.frameCount);
+    printf("%-6s %9s %11s %10s %10s %10s\n", "mode", "particles", "update ms", "submit ms", "submit p99",
+           "frames/s");
+    for (ParticleMode mode : kModes) {
+        if (!backend.supportsParticleMode(mode)) {
+            printf("%-6s not supported by %s\n", particleModeName(mode), backend.getName());
+            continue;
+        }
+        for (int particleCount : kParticleCounts) {
+            options.particleMode = mode;
+            options.particleCount = particleCount;
+            BenchResult result = runBench(backend, options);
+            printf("%-6s %9d %11.3f %10.3f %10.3f %10.1f\n", particleModeName(mode), particleCount,
+                   result.updateMean, result.cpuMean, result.cpuP99, result.framesPerSecond);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string backendName = "gles2";
+    BenchOptions options;
+    options.width = 1080;
+    options.height = 1920;
+    options.ballCount = 10;
+    options.radius = 0.0f;
+    options.particleCount = 100;
+    options.explosionSize = 25;
+    options.particleMode = PARTICLE_MODE_CPU;
+    options.frameCount = 600;
+    options.warmupCount = 60;
+    BallStyle ballStyle = BALL_STYLE_MESH;
+    bool sweep = false;
+    bool particleSweep = false;
+    bool explosionSet = false;
+    int gameRound = 0;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--backend" && hasValue) {
+            backendName = argv[++i];
+        } else if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--balls" && hasValue) {
+            options.ballCount = atoi(argv[++i]);
+        } else if (arg == "--radius" && hasValue) {
+            options.radius = static_cast<float>(atof(argv[++i]));
+        } else if (arg == "--ball-style" && hasValue) {
+            if (!parseBallStyle(argv[++i], &ballStyle)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--particles" && hasValue) {
+            options.particleCount = atoi(argv[++i]);
+        } else if (arg == "--explosion" && hasValue) {
+            options.explosionSize = atoi(argv[++i]);
+            explosionSet = true;
+        } else if (arg == "--particle-mode" && hasValue) {
+            if (!parseParticleMode(argv[++i], &options.particleMode)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--frames" && hasValue) {
+            options.frameCount = atoi(argv[++i]);
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmupCount = atoi(argv[++i]);
+        } else if (arg == "--sweep") {
+            sweep = true;
+        } else if (arg == "--particle-sweep") {
+            particleSweep = true;
+        } else if (arg == "--game" && hasValue) {
+            gameRound = atoi(argv[++i]);
+            if (gameRound <= 0) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (options.width <= 0 || options.height <= 0 || options.ballCount < 0 || options.radius < 0.0f ||
+        options.particleCount < 0 || options.explosionSize <= 0 || options.frameCount <= 0) {
+        usage();
+        return 1;
+    }
+    if (options.radius == 0.0f) {
+        options.radius = std::min(options.width, options.height) * 0.05f;
+    }
+
+    std::unique_ptr<RenderBackend> backend(createRenderBackend(backendName));
+    if (!backend) {
+        fprintf(stderr, "backend %s is not compiled in\n", backendName.c_str());
+        usage();
+        return 1;
+    }
+    if (!backend->init(nullptr, options.width, options.height, "")) {
+        fprintf(stderr, "cannot initialize %s offscreen\n", backendName.c_str());
+        return 1;
+    }
+
+    if (sweep) {
+        return runSweep(*backend, options);
+    }
+
+    if (!backend->setBallStyle(ballStyle)) {
+        fprintf(stderr, "%s cannot draw %s balls\n", backendName.c_str(), ballStyleName(ballStyle));
+        return 1;
+    }
+    if (particleSweep) {
+        // Sized like the larger explosions GPU mode is for
+        if (!explosionSet) options.explosionSize = 1000;
+        return runParticleSweep(*backend, options);
+    }
+    if (!backend->supportsParticleMode(options.particleMode)) {
+        fprintf(stderr, "%s cannot draw %s particles\n", backendName.c_str(),
+                particleModeName(options.particleMode));
+        return 1;
+    }
+    BenchResult result;
+    if (gameRound > 0) {
+        int endRound = 0;
+        int endScore = 0;
+        result = runGameBench(*backend, options, gameRound, seed, &endRound, &endScore);
+        printf("%s %dx%d, %s balls, autoplay from round %d (seed %u), %d frames: reached round %d, score %d\n",
+               backend->getName(), options.width, options.height, ballStyleName(ballStyle), gameRound, seed,
+               options.frameCount, endRound, endScore);
+        printf("  frame cpu ms (bot + update + submit): mean %.3f  p50 %.3f  p99 %.3f\n", result.cpuMean,
+               result.cpuP50, result.cpuP99);
+    } else {
+        result = runBench(*backend, options);
+        printf("%s %dx%d, %d %s balls (radius %.0f), %d %s particles, %d frames\n", backend->getName(),
+               options.width, options.height, options.ballCount, ballStyleName(ballStyle), options.radius,
+               options.particleCount, particleModeName(options.particleMode), options.frameCount);
+        printf("  update cpu ms: mean %.3f\n", result.updateMean);
+        printf("  submit cpu ms: mean %.3f  p50 %.3f  p99 %.3f\n", result.cpuMean, result.cpuP50, result.cpuP99);
+    }
+    printf("  frames/s (incl. gpu): %.1f\n", result.framesPerSecond);
+
+    std::string stats = backend->getStatsReport();
+    if (!stats.empty()) {
+        printf("  state calls over the measured frames:\n%s", stats.c_str());
+    }
+#ifdef TOUCHGAME_MOCK_GL
+    printf("  gl calls over the measured frames (mock driver):\n%s", mockgl::report().c_str());
+#endif
+    return 0;
+}
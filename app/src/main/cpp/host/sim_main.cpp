@@ -0,0 +1,172 @@
+// touchgame_sim: headless batch simulation of the difficulty curve.
+//
+//   touchgame_sim --games 10000 --seconds 300 --policy chase --out rounds.tgcols
+//   touchgame_sim --games 100 --policy autoplay --start-round 11
+
+#include "batch_sim.h"
+#include "level_table.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+static void usage() {
+    fprintf(stderr,
+        "usage: touchgame_sim [options]\n"
+        "  --games N          number of independent games (default 1000)\n"
+        "  --seconds S        simulated seconds per game (default 120)\n"
+        "  --dt S             fixed time step in seconds (default 1/60)\n"
+        "  --seed N           seed of game 0; game i uses seed+i (default 1)\n"
+        "  --threads N        worker threads, 0 = all cores (default 0)\n"
+        "  --size WxH         screen size in pixels (default 1080x1920)\n"
+        "  --policy P         chase | autoplay | random | script:<file> (default chase)\n"
+        "  --reaction S       chase/autoplay reaction time in seconds (default 0.25)\n"
+        "  --aim-error PX     chase/autoplay aim error std-dev in pixels, 0 for none (default 20)\n"
+        "  --start-round N    every game starts at round N (default 1)\n"
+        "  --tap-rate N       random taps per second (default 4)\n"
+        "  --loop             repeat the touch script\n"
+        "  --levels FILE      compiled level table (default: the build's levels.bin)\n"
+        "  --out FILE         write per-round columns to FILE\n");
+}
+
+int main(int argc, char** argv) {
+    BatchConfig config;
+    std::string policy = "chase";
+    std::string outPath;
+    float reaction = 0.25f;
+    float aimError = 20.0f;
+    float tapRate = 4.0f;
+    bool loop = false;
+    std::string levelsPath = TOUCHGAME_DEFAULT_LEVELS;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--games" && hasValue) {
+            config.gameCount = atoi(argv[++i]);
+        } else if (arg == "--seconds" && hasValue) {
+            config.duration = static_cast<float>(atof(argv[++i]));
+        } else if (arg == "--dt" && hasValue) {
+            config.timeStep = static_cast<float>(atof(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            config.firstSeed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--threads" && hasValue) {
+            config.threadCount = atoi(argv[++i]);
+        } else if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &config.screenWidth, &config.screenHeight) != 2 ||
+                config.screenWidth <= 0 || config.screenHeight <= 0) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--policy" && hasValue) {
+            policy = argv[++i];
+        } else if (arg == "--reaction" && hasValue) {
+            reaction = static_cast<float>(atof(argv[++i]));
+        } else if (arg == "--aim-error" && hasValue) {
+            aimError = static_cast<float>(atof(argv[++i]));
+        } else if (arg == "--start-round" && hasValue) {
+            config.startRound = atoi(argv[++i]);
+        } else if (arg == "--tap-rate" && hasValue) {
+            tapRate = static_cast<float>(atof(argv[++i]));
+        } else if (arg == "--loop") {
+            loop = true;
+        } else if (arg == "--levels" && hasValue) {
+            levelsPath = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else {
+            usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (config.gameCount <= 0 || config.duration <= 0.0f || config.timeStep <= 0.0f || !(aimError >= 0.0f)) {
+        usage();
+        return 1;
+    }
+
+    if (policy == "chase") {
+        config.policyFactory = [=] { return std::unique_ptr<InputPolicy>(new ChaseBotPolicy(reaction, aimError)); };
+    } else if (policy == "autoplay") {
+        AutoplayerConfig autoplay;
+        autoplay.reactionTime = reaction;
+        autoplay.aimErrorPx = aimError;
+        config.policyFactory = [=] { return std::unique_ptr<InputPolicy>(new AutoplayerPolicy(autoplay)); };
+    } else if (policy == "random") {
+        config.policyFactory = [=] { return std::unique_ptr<InputPolicy>(new RandomTapPolicy(tapRate)); };
+    } else if (policy.compare(0, 7, "script:") == 0) {
+        std::vector<ScriptedTouch> script;
+        if (!ScriptedPolicy::load(policy.substr(7), script)) {
+            fprintf(stderr, "cannot read touch script %s\n", policy.c_str() + 7);
+            return 1;
+        }
+        config.policyFactory = [=] { return std::unique_ptr<InputPolicy>(new ScriptedPolicy(script, loop)); };
+    } else {
+        usage();
+        return 1;
+    }
+
+    LevelTable levels;
+    if (!levels.mapFile(levelsPath)) {
+        fprintf(stderr, "cannot map level table %s\n", levelsPath.c_str());
+        return 1;
+    }
+    config.levels = &levels;
+
+    // Circles need room to spawn and move: at least a pixel of radius and
+    // less than half the screen on each axis, in the round games start at
+    int minDimension = std::min(config.screenWidth, config.screenHeight);
+    float radius = minDimension * levels.round(std::max(config.startRound, 1)).radius;
+    if (radius < 1.0f || 2.0f * radius >= minDimension) {
+        fprintf(stderr, "screen %dx%d is too small for a %.2f px circle\n", config.screenWidth,
+                config.screenHeight, radius);
+        return 1;
+    }
+
+    BatchResult result = runBatch(config);
+
+    printf("%d games x %.0f s on %d threads: %.2f s wall, %.2fM game-seconds/minute\n",
+           config.gameCount, config.duration, result.threadCount, result.wallSeconds,
+           result.simulatedGameSeconds / result.wallSeconds * 60.0 / 1e6);
+
+    // Per-round summary over all games
+    struct Summary {
+        long played = 0;
+        long cleared = 0;
+        double clearTime = 0.0;
+        long hits = 0;
+        long misses = 0;
+    };
+    std::map<int, Summary> summaries;
+    const RoundColumns& rounds = result.rounds;
+    for (size_t i = 0; i < rounds.size(); i++) {
+        Summary& s = summaries[rounds.round[i]];
+        s.played++;
+        s.hits += rounds.hits[i];
+        s.misses += rounds.misses[i];
+        if (rounds.cleared[i]) {
+            s.cleared++;
+            s.clearTime += rounds.clearTime[i];
+        }
+    }
+
+    printf("%6s %9s %9s %12s %9s\n", "round", "played", "cleared", "mean clear", "accuracy");
+    for (const auto& entry : summaries) {
+        const Summary& s = entry.second;
+        long touches = s.hits + s.misses;
+        printf("%6d %9ld %9ld %11.2fs %8.1f%%\n", entry.first, s.played, s.cleared,
+               s.cleared ? s.clearTime / s.cleared : 0.0,
+               touches ? 100.0 * s.hits / touches : 0.0);
+    }
+
+    if (!outPath.empty()) {
+        if (!writeColumnar(rounds, outPath)) {
+            fprintf(stderr, "failed to write %s\n", outPath.c_str());
+            return 1;
+        }
+        printf("wrote %zu rounds to %s\n", rounds.size(), outPath.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "hud.h"
+#include <cstdio>
+#include <cstring>
+
+// Text height as a fraction of the screen height (whole glyph cell)
+static const float kCellHeightFraction = 0.045f;
+
+Hud::Hud() : screenWidth(0), screenHeight(0), cellHeight(0.0f), smoothing(0.1f),
+             score(-1), round(-1), darkText(false), version(0) {
+}
+
+void Hud::init(int width, int height) {
+    screenWidth = width;
+    screenHeight = height;
+    cellHeight = height * kCellHeightFraction;
+
+    // One screen pixel spans this many atlas texels; widen the edge ramp to
+    // about one pixel so the text stays anti-aliased at any size
+    float texelsPerPixel = SdfFont::CELL_HEIGHT / cellHeight;
+    smoothing = 0.7f * texelsPerPixel / (2.0f * SdfFont::SPREAD);
+
+    score = -1;
+    round = -1;
+}
+
+void Hud::setValues(int newScore, int newRound, bool newDarkText) {
+    if (newScore == score && newRound == round && newDarkText == darkText) return;
+
+    score = newScore;
+    round = newRound;
+    darkText = newDarkText;
+    layout();
+}
+
+void Hud::layout() {
+    char text[64];
+    snprintf(text, sizeof(text), "SCORE: %d   ROUND: %d", score, round);
+    size_t length = strlen(text);
+
+    float cellWidth = cellHeight * SdfFont::glyphAspect();
+    float advance = cellWidth * SdfFont::GLYPH_ADVANCE / SdfFont::CELL_WIDTH;
+    float textWidth = advance * (length - 1) + cellWidth;
+    float x = (screenWidth - textWidth) * 0.5f;
+    float y = cellHeight * 0.5f;
+
+    vertices.clear();
+    for (size_t i = 0; i < length; i++, x += advance) {
+        const GlyphInfo* glyph = SdfFont::glyph(text[i]);
+        if (glyph == nullptr || text[i] == ' ') continue;
+
+        float left = 2.0f * x / screenWidth - 1.0f;
+        float right = 2.0f * (x + cellWidth) / screenWidth - 1.0f;
+        float top = 1.0f - 2.0f * y / screenHeight;
+        float bottom = 1.0f - 2.0f * (y + cellHeight) / screenHeight;
+
+        const float quad[6 * FLOATS_PER_VERTEX] = {
+            left,  top,    glyph->u0, glyph->v0,
+            left,  bottom, glyph->u0, glyph->v1,
+            right, top,    glyph->u1, glyph->v0,
+            right, top,    glyph->u1, glyph->v0,
+            left,  bottom, glyph->u0, glyph->v1,
+            right, bottom, glyph->u1, glyph->v1,
+        };
+        vertices.insert(vertices.end(), quad, quad + 6 * FLOATS_PER_VERTEX);
+    }
+    version++;
+}
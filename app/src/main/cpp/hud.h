@@ -0,0 +1,46 @@
+#ifndef TOUCHGAME_HUD_H
+#define TOUCHGAME_HUD_H
+
+#include <cstdint>
+#include <vector>
+#include "sdf_font.h"
+
+// Score/round overlay layout.
+//
+// Produces one textured quad per glyph (two triangles of x, y, u, v in GL
+// normalized device coordinates, y up) referencing the SdfFont atlas. The
+// vertices are rebuilt only when the score, round or text color changes;
+// renderers compare getVersion() with what they last uploaded and draw the
+// whole HUD in a single call.
+class Hud {
+public:
+    static const int FLOATS_PER_VERTEX = 4;
+
+    Hud();
+
+    void init(int screenWidth, int screenHeight);
+    void setValues(int score, int round, bool darkText);
+
+    const std::vector<float>& getVertices() const { return vertices; }
+    int getVertexCount() const { return static_cast<int>(vertices.size()) / FLOATS_PER_VERTEX; }
+    uint32_t getVersion() const { return version; }
+    bool isDarkText() const { return darkText; }
+    // Distance-field units covered by one screen pixel, for edge smoothing
+    float getSmoothing() const { return smoothing; }
+
+private:
+    void layout();
+
+    int screenWidth;
+    int screenHeight;
+    float cellHeight;    // pixels
+    float smoothing;
+
+    int score;
+    int round;
+    bool darkText;
+    uint32_t version;
+    std::vector<float> vertices;
+};
+
+#endif // TOUCHGAME_HUD_H
@@ -0,0 +1,186 @@
+#include "latency.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+static const char* const kStageNames[STAGE_COUNT] = {
+    "input->sim",
+    "sim->submit",
+    "submit->present",
+    "input->present",
+};
+
+int64_t monotonicNowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void LatencyHistogram::record(int64_t latencyNs) {
+    if (latencyNs < 0) latencyNs = 0;
+
+    int bucket = static_cast<int>(std::min<int64_t>(latencyNs / BUCKET_WIDTH_NS, BUCKET_COUNT - 1));
+    buckets[bucket]++;
+    count++;
+    sumNs += latencyNs;
+    minNs = std::min(minNs, latencyNs);
+    maxNs = std::max(maxNs, latencyNs);
+}
+
+void LatencyHistogram::reset() {
+    count = 0;
+    sumNs = 0;
+    minNs = INT64_MAX;
+    maxNs = 0;
+    std::fill(buckets, buckets + BUCKET_COUNT, 0);
+}
+
+int64_t LatencyHistogram::percentileNs(float p) const {
+    if (count == 0) return 0;
+
+    int64_t target = static_cast<int64_t>(p * count);
+    int64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen > target) {
+            // Upper edge of the bucket, clamped to the largest sample
+            return std::min((i + 1) * BUCKET_WIDTH_NS, maxNs);
+        }
+    }
+    return maxNs;
+}
+
+void LatencyTracker::onTouch(int64_t eventTimeNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    handledTouches.push_back(eventTimeNs);
+}
+
+void LatencyTracker::beginUpdate(int64_t nowNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    frameTouches.clear();
+    for (int64_t eventNs : handledTouches) {
+        histograms[STAGE_INPUT_TO_SIM].record(nowNs - eventNs);
+        frameTouches.push_back({eventNs, nowNs});
+    }
+    handledTouches.clear();
+}
+
+bool LatencyTracker::submitFrame(int64_t nowNs, uint64_t frameId, bool hasFrameId) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (frameTouches.empty()) return false;
+
+    for (const auto& touch : frameTouches) {
+        histograms[STAGE_SIM_TO_SUBMIT].record(nowNs - touch.simNs);
+    }
+
+    if (!presentTimesAvailable || !hasFrameId) {
+        frameTouches.clear();
+        return false;
+    }
+
+    if (pendingFrames.size() >= MAX_PENDING_FRAMES) {
+        // The compositor never reported this one; give up on it
+        pendingFrames.pop_front();
+        droppedFrames++;
+    }
+    pendingFrames.push_back({frameId, nowNs, std::move(frameTouches)});
+    frameTouches.clear();
+    return true;
+}
+
+void LatencyTracker::onFramePresented(uint64_t frameId, int64_t presentNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = pendingFrames.begin(); it != pendingFrames.end(); ++it) {
+        if (it->frameId != frameId) continue;
+
+        histograms[STAGE_SUBMIT_TO_PRESENT].record(presentNs - it->submitNs);
+        for (const auto& touch : it->touches) {
+            histograms[STAGE_INPUT_TO_PRESENT].record(presentNs - touch.eventNs);
+        }
+        pendingFrames.erase(it);
+        return;
+    }
+}
+
+void LatencyTracker::onFramePresentUnknown(uint64_t frameId) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = pendingFrames.begin(); it != pendingFrames.end(); ++it) {
+        if (it->frameId == frameId) {
+            pendingFrames.erase(it);
+            droppedFrames++;
+            return;
+        }
+    }
+}
+
+std::vector<uint64_t> LatencyTracker::pendingPresentFrames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<uint64_t> ids;
+    ids.reserve(pendingFrames.size());
+    for (const auto& frame : pendingFrames) {
+        ids.push_back(frame.frameId);
+    }
+    return ids;
+}
+
+void LatencyTracker::setPresentTimesAvailable(bool available) {
+    std::lock_guard<std::mutex> lock(mutex);
+    presentTimesAvailable = available;
+    if (!available) pendingFrames.clear();
+}
+
+void LatencyTracker::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& histogram : histograms) {
+        histogram.reset();
+    }
+    droppedFrames = 0;
+}
+
+std::vector<int64_t> LatencyTracker::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<int64_t> values;
+    values.reserve(STAGE_COUNT * VALUES_PER_STAGE);
+    for (const auto& histogram : histograms) {
+        values.push_back(histogram.count);
+        values.push_back(histogram.sumNs);
+        values.push_back(histogram.count ? histogram.minNs : 0);
+        values.push_back(histogram.maxNs);
+        values.insert(values.end(), histogram.buckets, histogram.buckets + LatencyHistogram::BUCKET_COUNT);
+    }
+    return values;
+}
+
+std::string LatencyTracker::report() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::string result;
+    char line[160];
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        const LatencyHistogram& h = histograms[stage];
+        if (h.count == 0) {
+            bool needsPresent = stage == STAGE_SUBMIT_TO_PRESENT || stage == STAGE_INPUT_TO_PRESENT;
+            snprintf(line, sizeof(line), "%-16s no samples%s\n", kStageNames[stage],
+                     needsPresent && !presentTimesAvailable ? " (present timestamps unsupported)" : "");
+        } else {
+            snprintf(line, sizeof(line),
+                     "%-16s n=%lld mean=%.1fms p50=%.1fms p90=%.1fms p99=%.1fms max=%.1fms\n",
+                     kStageNames[stage], (long long)h.count,
+                     h.sumNs / 1e6 / h.count,
+                     h.percentileNs(0.50f) / 1e6, h.percentileNs(0.90f) / 1e6,
+                     h.percentileNs(0.99f) / 1e6, h.maxNs / 1e6);
+        }
+        result += line;
+    }
+    if (droppedFrames > 0) {
+        snprintf(line, sizeof(line), "%lld frames never reported a present time\n", (long long)droppedFrames);
+        result += line;
+    }
+    return result;
+}
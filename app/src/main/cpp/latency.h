@@ -0,0 +1,96 @@
+#ifndef TOUCHGAME_LATENCY_H
+#define TOUCHGAME_LATENCY_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Touch-to-photon latency tracking.
+//
+// A touch is timestamped by the input system (MotionEvent event time), then
+// tagged through the first update that runs after it was handled, the frame
+// submission (eglSwapBuffers) that carries its effect, and finally the time
+// that frame reached the display. All timestamps are CLOCK_MONOTONIC ns.
+
+enum LatencyStage {
+    STAGE_INPUT_TO_SIM = 0,      // event time -> start of the consuming update
+    STAGE_SIM_TO_SUBMIT,         // update start -> eglSwapBuffers
+    STAGE_SUBMIT_TO_PRESENT,     // eglSwapBuffers -> display present time
+    STAGE_INPUT_TO_PRESENT,      // end to end
+    STAGE_COUNT
+};
+
+class LatencyHistogram {
+public:
+    static const int BUCKET_COUNT = 101; // 1 ms buckets, last one is >= 100 ms
+    static const int64_t BUCKET_WIDTH_NS = 1000000;
+
+    LatencyHistogram() { reset(); }
+
+    void record(int64_t latencyNs);
+    void reset();
+    int64_t percentileNs(float p) const;
+
+    int64_t count;
+    int64_t sumNs;
+    int64_t minNs;
+    int64_t maxNs;
+    int64_t buckets[BUCKET_COUNT];
+};
+
+class LatencyTracker {
+public:
+    LatencyTracker() : presentTimesAvailable(false), droppedFrames(0) {}
+
+    // Input thread: a touch with the given event time has just been handled
+    void onTouch(int64_t eventTimeNs);
+
+    // Render thread, once per frame, in order
+    void beginUpdate(int64_t nowNs);
+    // Returns true if this frame carries touches and its present time should
+    // be queried later under frameId
+    bool submitFrame(int64_t nowNs, uint64_t frameId, bool hasFrameId);
+    void onFramePresented(uint64_t frameId, int64_t presentNs);
+    void onFramePresentUnknown(uint64_t frameId);
+
+    // Frames still waiting for a present timestamp, oldest first
+    std::vector<uint64_t> pendingPresentFrames() const;
+
+    void setPresentTimesAvailable(bool available);
+    void reset();
+
+    // Flattened histograms: for each stage, count, sum, min, max and then
+    // BUCKET_COUNT bucket counts (all in ns / counts)
+    std::vector<int64_t> snapshot() const;
+    std::string report() const;
+
+    static const int VALUES_PER_STAGE = 4 + LatencyHistogram::BUCKET_COUNT;
+
+private:
+    struct TouchSample {
+        int64_t eventNs;
+        int64_t simNs;
+    };
+
+    struct PendingFrame {
+        uint64_t frameId;
+        int64_t submitNs;
+        std::vector<TouchSample> touches;
+    };
+
+    static const size_t MAX_PENDING_FRAMES = 16;
+
+    mutable std::mutex mutex;
+    std::vector<int64_t> handledTouches;   // event times waiting for an update
+    std::vector<TouchSample> frameTouches; // consumed by the current update
+    std::deque<PendingFrame> pendingFrames;
+    LatencyHistogram histograms[STAGE_COUNT];
+    bool presentTimesAvailable;
+    int64_t droppedFrames;
+};
+
+int64_t monotonicNowNs();
+
+#endif // TOUCHGAME_LATENCY_H
@@ -0,0 +1,129 @@
+#include "level_table.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Image of the fallback table: round 1 of levels.txt repeated forever
+struct FallbackImage {
+    LevelTableHeader header;
+    RoundDef rounds[1];
+    EffectDef effects[1];
+};
+
+static_assert(offsetof(FallbackImage, rounds) % LevelTable::RECORD_ALIGNMENT == 0 &&
+              offsetof(FallbackImage, effects) % LevelTable::RECORD_ALIGNMENT == 0,
+              "fallback records must be laid out like a compiled table");
+
+const FallbackImage kFallback = {
+    {{'T', 'G', 'L', 'E', 'V', 'E', 'L', 'S'}, LevelTable::VERSION, sizeof(FallbackImage),
+     1, offsetof(FallbackImage, rounds), 1, offsetof(FallbackImage, effects),
+     100.0f, 600.0f, {0, 0, 0, 0, 0, 0}},
+    {{0.10f, 500.0f, 1, 1, 0, 0}},
+    {{20, 30, 200.0f, 600.0f, 200.0f, 0.15f, 0.25f, 0.2f, 0.5f, 1.0f, {0, 0, 0}}},
+};
+
+bool isAligned(uint32_t offset) {
+    return offset % LevelTable::RECORD_ALIGNMENT == 0;
+}
+
+} // namespace
+
+LevelTable::LevelTable()
+    : mapping(nullptr), mappingSize(0), header(nullptr), rounds(nullptr), effects(nullptr) {
+}
+
+LevelTable::~LevelTable() {
+    unmap();
+}
+
+void LevelTable::unmap() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+    header = nullptr;
+    rounds = nullptr;
+    effects = nullptr;
+}
+
+bool LevelTable::mapFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat info;
+    bool mapped = fstat(fd, &info) == 0 && mapDescriptor(fd, 0, info.st_size);
+    close(fd);
+    return mapped;
+}
+
+bool LevelTable::mapDescriptor(int fd, int64_t offset, int64_t length) {
+    unmap();
+    if (offset < 0 || length < static_cast<int64_t>(sizeof(LevelTableHeader))) return false;
+
+    // mmap wants a page-aligned offset; assets start anywhere in the APK
+    int64_t pageSize = sysconf(_SC_PAGESIZE);
+    int64_t delta = offset % pageSize;
+    size_t size = static_cast<size_t>(length + delta);
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, offset - delta);
+    if (address == MAP_FAILED) return false;
+
+    mapping = address;
+    mappingSize = size;
+    if (!attach(static_cast<const uint8_t*>(address) + delta, static_cast<size_t>(length))) {
+        unmap();
+        return false;
+    }
+    return true;
+}
+
+bool LevelTable::attach(const void* data, size_t size) {
+    // Records are read in place, so the image itself must be aligned too
+    if (size < sizeof(LevelTableHeader) ||
+        reinterpret_cast<uintptr_t>(data) % alignof(LevelTableHeader) != 0) {
+        return false;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const LevelTableHeader* candidate = reinterpret_cast<const LevelTableHeader*>(bytes);
+    if (memcmp(candidate->magic, "TGLEVELS", sizeof(candidate->magic)) != 0 ||
+        candidate->version != VERSION || candidate->fileSize != size ||
+        candidate->roundCount == 0 || candidate->effectCount == 0 ||
+        !isAligned(candidate->roundsOffset) || !isAligned(candidate->effectsOffset)) {
+        return false;
+    }
+
+    uint64_t roundsEnd = candidate->roundsOffset + uint64_t(candidate->roundCount) * sizeof(RoundDef);
+    uint64_t effectsEnd = candidate->effectsOffset + uint64_t(candidate->effectCount) * sizeof(EffectDef);
+    if (candidate->roundsOffset < sizeof(LevelTableHeader) || roundsEnd > size ||
+        candidate->effectsOffset < sizeof(LevelTableHeader) || effectsEnd > size) {
+        return false;
+    }
+
+    // Effect indices are checked once here instead of on every explosion
+    const RoundDef* candidateRounds = reinterpret_cast<const RoundDef*>(bytes + candidate->roundsOffset);
+    for (uint32_t i = 0; i < candidate->roundCount; i++) {
+        const RoundDef& def = candidateRounds[i];
+        if (def.effect >= candidate->effectCount || def.circlesMin == 0 ||
+            def.circlesMax < def.circlesMin || !(def.radius > 0.0f && def.radius < 0.5f)) {
+            return false;
+        }
+    }
+
+    header = candidate;
+    rounds = candidateRounds;
+    effects = reinterpret_cast<const EffectDef*>(bytes + candidate->effectsOffset);
+    return true;
+}
+
+const LevelTable& LevelTable::fallback() {
+    // Function-local statics: initialized once even with games on several threads
+    static LevelTable table;
+    static bool attached = table.attach(&kFallback, sizeof(kFallback));
+    (void)attached;
+    return table;
+}
@@ -0,0 +1,108 @@
+#ifndef TOUCHGAME_LEVEL_TABLE_H
+#define TOUCHGAME_LEVEL_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Difficulty curve and particle effects as a flat binary table.
+//
+// levels/levels.txt is compiled by touchgame_levelc (host/level_compiler.cpp)
+// into levels.bin, which ships as an uncompressed APK asset. At runtime the
+// file is mapped read-only and used in place: a header followed by
+// fixed-size round and effect records, each array 16-byte aligned within
+// the file, so a round lookup is an array index and nothing is parsed at
+// startup. All fields are little-endian.
+
+struct LevelTableHeader {
+    char magic[8];           // "TGLEVELS"
+    uint32_t version;        // LevelTable::VERSION
+    uint32_t fileSize;
+    uint32_t roundCount;     // at least 1
+    uint32_t roundsOffset;   // from the start of the file
+    uint32_t effectCount;    // at least 1
+    uint32_t effectsOffset;
+    float tailSpeedStep;     // px/s added per round past the last record
+    float gravity;           // px/s^2 pulling particles down
+    uint32_t reserved[6];
+};
+
+// Round r uses record min(r, roundCount) - 1
+struct RoundDef {
+    float radius;            // fraction of the smaller screen dimension
+    float speed;             // px/s
+    uint16_t circlesMin;
+    uint16_t circlesMax;     // uniform random count when above circlesMin
+    uint16_t effect;         // explosion when a circle is hit
+    uint16_t reserved;
+};
+
+struct EffectDef {
+    uint16_t particlesMin;
+    uint16_t particlesMax;
+    float speedMin;          // px/s
+    float speedMax;
+    float upwardBias;        // px/s subtracted from the initial y velocity
+    float sizeMin;           // fraction of the circle radius
+    float sizeMax;
+    float colorJitter;       // +/- half this around the circle color
+    float lifetimeMin;       // seconds
+    float lifetimeMax;
+    uint32_t reserved[3];
+};
+
+static_assert(sizeof(LevelTableHeader) == 64, "LevelTableHeader is a file format");
+static_assert(sizeof(RoundDef) == 16, "RoundDef is a file format");
+static_assert(sizeof(EffectDef) == 48, "EffectDef is a file format");
+
+class LevelTable {
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t RECORD_ALIGNMENT = 16;
+
+    LevelTable();
+    ~LevelTable();
+    LevelTable(const LevelTable&) = delete;
+    LevelTable& operator=(const LevelTable&) = delete;
+
+    // Map a table file, or `length` bytes at `offset` of an open descriptor
+    // (an APK asset from AAsset_openFileDescriptor). The descriptor may be
+    // closed afterwards.
+    bool mapFile(const std::string& path);
+    bool mapDescriptor(int fd, int64_t offset, int64_t length);
+    // Use a table image owned by the caller; it must outlive this object
+    bool attach(const void* data, size_t size);
+
+    bool isLoaded() const { return header != nullptr; }
+    int getRoundCount() const { return static_cast<int>(header->roundCount); }
+    int getEffectCount() const { return static_cast<int>(header->effectCount); }
+    float getGravity() const { return header->gravity; }
+
+    const RoundDef& round(int round) const {
+        uint32_t index = round < 1 ? 0 : static_cast<uint32_t>(round) - 1;
+        return rounds[index < header->roundCount ? index : header->roundCount - 1];
+    }
+    // The record's speed, extended past the last record by tailSpeedStep
+    float speedForRound(int round) const {
+        int extra = round - static_cast<int>(header->roundCount);
+        return this->round(round).speed + (extra > 0 ? extra * header->tailSpeedStep : 0.0f);
+    }
+    const EffectDef& effect(uint16_t index) const {
+        return effects[index < header->effectCount ? index : 0];
+    }
+
+    // A one-round table used when levels.bin is missing or invalid, so the
+    // game stays playable: fixed size and count, speed rising every round
+    static const LevelTable& fallback();
+
+private:
+    void unmap();
+
+    void* mapping;
+    size_t mappingSize;
+    const LevelTableHeader* header;
+    const RoundDef* rounds;
+    const EffectDef* effects;
+};
+
+#endif // TOUCHGAME_LEVEL_TABLE_H
@@ -1,22 +1,186 @@
 #include <jni.h>
+#include <android/asset_manager_jni.h>
 #include <android/native_window_jni.h>
-#include <GLES2/gl2.h>
-#include <EGL/egl.h>
+#include <sys/system_properties.h>
+#include <unistd.h>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include "autoplayer.h"
 #include "game.h"
+#include "event_log.h"
+#include "latency.h"
+#include "level_table.h"
+#include "render_backend.h"
+#include "startup.h"
 
 static Game* game = nullptr;
-static EGLDisplay display = EGL_NO_DISPLAY;
-static EGLSurface surface = EGL_NO_SURFACE;
-static EGLContext context = EGL_NO_CONTEXT;
+static RenderBackend* backend = nullptr;
 static ANativeWindow* window = nullptr;
 static std::chrono::high_resolution_clock::time_point lastTime;
 static bool initialized = false;
 
+// Difficulty curve, mapped from the APK once per process and shared by
+// every Game instance
+static LevelTable levelTable;
+
+// Touch-to-photon latency, fed from nativeTouch and nativeRender
+static LatencyTracker latencyTracker;
+
+// Debug autoplayer, a load generator for soak tests and frame-time
+// measurements: toggled with a three-finger tap in debug builds, or from
+// launch with `adb shell setprop debug.touchgame.autoplay ROUND[,REACTION_MS[,AIM_PX]]`
+// (ROUND 0 turns it off). Runs on the render thread; its taps take the
+// touchscreen's path.
+static Autoplayer autoplayer;
+static std::atomic<bool> autoplayEnabled(false);
+static bool autoplayRunning = false; // render thread's view of autoplayEnabled
+static float autoplayClock = 0.0f;   // seconds since the bot took over
+
+// Cold start: timeline, and what the preload thread prepared during the
+// splash for nativeInit to adopt
+static StartupReport startupReport;
+static std::mutex preloadMutex;
+static RenderBackend* preloadedBackend = nullptr;
+static Game* preloadedGame = nullptr;
+static bool firstFramePending = false;
+
 // Store Java VM and GameView object for callbacks
 static JavaVM* g_jvm = nullptr;
 static jobject g_gameViewObj = nullptr;
 
+// Backend used when GameView passes no explicit renderer; overridable for
+// testing with `adb shell setprop debug.touchgame.renderer <name>`
+static std::string defaultRendererName() {
+    char value[PROP_VALUE_MAX] = {0};
+    if (__system_property_get("debug.touchgame.renderer", value) > 0) {
+        return value;
+    }
+    return "gles2";
+}
+
+// Balls as tessellated meshes unless a device is set to trade vertex load
+// for fill rate: `adb shell setprop debug.touchgame.balls impostor`
+static BallStyle defaultBallStyle() {
+    char value[PROP_VALUE_MAX] = {0};
+    BallStyle style = BALL_STYLE_MESH;
+    if (__system_property_get("debug.touchgame.balls", value) > 0) {
+        parseBallStyle(value, &style);
+    }
+    return style;
+}
+
+// Explosions simulated per particle on the CPU unless a device is set to
+// evaluate them in the vertex shader or keep them quantized:
+// `adb shell setprop debug.touchgame.particles gpu|packed`
+static ParticleMode defaultParticleMode() {
+    char value[PROP_VALUE_MAX] = {0};
+    ParticleMode mode = PARTICLE_MODE_CPU;
+    if (__system_property_get("debug.touchgame.particles", value) > 0) {
+        parseParticleMode(value, &mode);
+    }
+    return mode;
+}
+
+// Starts the bot at the property's round, if set; otherwise leaves the
+// current toggle alone
+static void applyAutoplayProperty() {
+    char value[PROP_VALUE_MAX] = {0};
+    if (__system_property_get("debug.touchgame.autoplay", value) <= 0) return;
+
+    int round = 0;
+    float reactionMs = 250.0f;
+    float aimErrorPx = 12.0f;
+    if (sscanf(value, "%d,%f,%f", &round, &reactionMs, &aimErrorPx) < 1 || round <= 0) {
+        autoplayEnabled = false;
+        return;
+    }
+
+    AutoplayerConfig config;
+    config.reactionTime = reactionMs / 1000.0f;
+    config.aimErrorPx = aimErrorPx; // clamped to >= 0 by setConfig()
+    autoplayer.setConfig(config);
+    game->startRound(round);
+    autoplayEnabled = true;
+}
+
+// Everything a tap does, whether from the touchscreen or the autoplayer
+static bool dispatchTouch(float x, float y, int64_t eventTimeNs) {
+    bool hit = game->handleTouch(x, y);
+    latencyTracker.onTouch(eventTimeNs);
+    return hit;
+}
+
+static std::string toStdString(JNIEnv* env, jstring value, const std::string& fallback) {
+    if (value == nullptr) return fallback;
+    const char* chars = env->GetStringUTFChars(value, nullptr);
+    std::string result = chars;
+    env->ReleaseStringUTFChars(value, chars);
+    return result;
+}
+
+// Maps levels.bin straight out of the APK. The asset is stored uncompressed
+// (noCompress in build.gradle), so AAsset_openFileDescriptor gives the APK's
+// descriptor and the table's byte range in it; nothing is read or parsed.
+static void loadLevelTable(JNIEnv* env, jobject jAssets) {
+    if (levelTable.isLoaded() || jAssets == nullptr) return;
+    
+    AAssetManager* assets = AAssetManager_fromJava(env, jAssets);
+    AAsset* asset = assets ? AAssetManager_open(assets, "levels.bin", AASSET_MODE_UNKNOWN) : nullptr;
+    if (asset != nullptr) {
+        off64_t start = 0;
+        off64_t length = 0;
+        int fd = AAsset_openFileDescriptor64(asset, &start, &length);
+        if (fd >= 0) {
+            levelTable.mapDescriptor(fd, start, length);
+            close(fd);
+        }
+        AAsset_close(asset);
+    }
+    
+    if (levelTable.isLoaded()) {
+        ELOGI(EventId::LevelsLoaded, levelTable.getRoundCount(), levelTable.getEffectCount());
+    } else {
+        ELOGW(EventId::LevelsMissing);
+    }
+}
+
+// Resolves present times for frames that carried touches
+static void pollPresentTimes() {
+    if (!backend->supportsPresentTimes()) return;
+    
+    for (uint64_t frameId : latencyTracker.pendingPresentFrames()) {
+        int64_t presentTime = 0;
+        switch (backend->queryPresentTime(frameId, &presentTime)) {
+            case PRESENT_TIME_AVAILABLE:
+                latencyTracker.onFramePresented(frameId, presentTime);
+                break;
+            case PRESENT_TIME_UNKNOWN:
+                latencyTracker.onFramePresentUnknown(frameId);
+                break;
+            case PRESENT_TIME_PENDING:
+                break;
+        }
+    }
+}
+
+static void destroyRenderer() {
+    if (game) {
+        delete game;
+        game = nullptr;
+    }
+    if (backend) {
+        delete backend;
+        backend = nullptr;
+    }
+    if (window) {
+        ANativeWindow_release(window);
+        window = nullptr;
+    }
+}
+
 // Helper function to show toast from native code
 void showToast(const char* message) {
     if (g_jvm == nullptr || g_gameViewObj == nullptr) return;
@@ -50,8 +214,78 @@ void showToast(const char* message) {
 
 extern "C" {
 
+// Preload thread, while the splash is visible: everything that needs no
+// window. width x height is the predicted GameView size for round 1.
 JNIEXPORT void JNICALL
-Java_com_rog3rb0t_touchgame_GameView_nativeInit(JNIEnv* env, jobject obj, jobject jSurface) {
+Java_com_rog3rb0t_touchgame_ColdStart_nativePreload(JNIEnv* env, jclass clazz, jstring jCacheDir,
+                                                    jobject jAssets, jstring jRenderer,
+                                                    jint width, jint height) {
+    eventlog::installCrashHandler();
+    
+    startupReport.begin(STARTUP_LEVELS_MAP);
+    loadLevelTable(env, jAssets);
+    startupReport.end(STARTUP_LEVELS_MAP);
+    
+    std::string cacheDir = toStdString(env, jCacheDir, "");
+    std::string rendererName = toStdString(env, jRenderer, defaultRendererName());
+    
+    startupReport.begin(STARTUP_RENDERER_PRELOAD);
+    RenderBackend* renderer = createRenderBackend(rendererName);
+    if (renderer != nullptr && !renderer->preload(cacheDir)) {
+        startupReport.addNote(rendererName + " has no windowless setup; initialized on the render thread");
+        delete renderer;
+        renderer = nullptr;
+    }
+    startupReport.end(STARTUP_RENDERER_PRELOAD);
+    
+    startupReport.begin(STARTUP_ROUND_PREGENERATE);
+    Game* pregenerated = nullptr;
+    if (width > 0 && height > 0) {
+        pregenerated = new Game();
+        pregenerated->setLevelTable(levelTable.isLoaded() ? &levelTable : nullptr);
+        pregenerated->init(width, height);
+    }
+    startupReport.end(STARTUP_ROUND_PREGENERATE);
+    
+    std::lock_guard<std::mutex> lock(preloadMutex);
+    delete preloadedBackend;
+    delete preloadedGame;
+    preloadedBackend = renderer;
+    preloadedGame = pregenerated;
+}
+
+// Phases timed on the Java side (process start, activities, library load)
+JNIEXPORT void JNICALL
+Java_com_rog3rb0t_touchgame_ColdStart_nativeRecordPhase(JNIEnv* env, jclass clazz, jint phase,
+                                                        jlong beginNs, jlong endNs) {
+    if (phase < 0 || phase >= STARTUP_PHASE_COUNT) return;
+    startupReport.record(static_cast<StartupPhase>(phase), beginNs, endNs);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_rog3rb0t_touchgame_ColdStart_nativeGetReport(JNIEnv* env, jclass clazz) {
+    return env->NewStringUTF(startupReport.report().c_str());
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_rog3rb0t_touchgame_ColdStart_nativeGetTimes(JNIEnv* env, jclass clazz) {
+    std::vector<int64_t> values = startupReport.snapshot();
+    jlongArray result = env->NewLongArray(static_cast<jsize>(values.size()));
+    if (result != nullptr) {
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(values.size()),
+                                reinterpret_cast<const jlong*>(values.data()));
+    }
+    return result;
+}
+
+// Render thread, once the surface exists and the preload thread is done.
+// Returns false if no renderer could be initialized.
+JNIEXPORT jboolean JNICALL
+Java_com_rog3rb0t_touchgame_GameView_nativeInit(JNIEnv* env, jobject obj, jobject jSurface,
+                                                jstring jCacheDir, jstring jRenderer, jobject jAssets) {
+    // Dump the event log to logcat if we crash
+    eventlog::installCrashHandler();
+    
     // Store Java VM and GameView object for callbacks
     env->GetJavaVM(&g_jvm);
     if (g_gameViewObj != nullptr) {
@@ -60,80 +294,106 @@ Java_com_rog3rb0t_touchgame_GameView_nativeInit(JNIEnv* env, jobject obj, jobjec
     g_gameViewObj = env->NewGlobalRef(obj);
     
     // Clean up any existing resources first
-    if (context != EGL_NO_CONTEXT) {
-        eglDestroyContext(display, context);
-        context = EGL_NO_CONTEXT;
-    }
-    if (surface != EGL_NO_SURFACE) {
-        eglDestroySurface(display, surface);
-        surface = EGL_NO_SURFACE;
-    }
-    if (display != EGL_NO_DISPLAY) {
-        eglTerminate(display);
-        display = EGL_NO_DISPLAY;
-    }
-    if (game != nullptr) {
-        delete game;
-        game = nullptr;
-    }
-    
-    window = ANativeWindow_fromSurface(env, jSurface);
-    
-    // Initialize EGL
-    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-    eglInitialize(display, nullptr, nullptr);
-    
-    const EGLint attribs[] = {
-        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
-        EGL_BLUE_SIZE, 8,
-        EGL_GREEN_SIZE, 8,
-        EGL_RED_SIZE, 8,
-        EGL_NONE
-    };
-    
-    EGLConfig config;
-    EGLint numConfigs;
-    eglChooseConfig(display, attribs, &config, 1, &numConfigs);
+    initialized = false;
+    destroyRenderer();
     
-    EGLint format;
-    eglGetConfigAttrib(display, config, EGL_NATIVE_VISUAL_ID, &format);
-    ANativeWindow_setBuffersGeometry(window, 0, 0, format);
+    std::string cacheDir = toStdString(env, jCacheDir, "");
+    std::string rendererName = toStdString(env, jRenderer, defaultRendererName());
     
-    surface = eglCreateWindowSurface(display, config, window, nullptr);
+    startupReport.begin(STARTUP_RENDERER_ATTACH);
+    loadLevelTable(env, jAssets);
     
-    const EGLint contextAttribs[] = {
-        EGL_CONTEXT_CLIENT_VERSION, 2,
-        EGL_NONE
-    };
+    // Adopt whatever the preload thread prepared (only ever on cold start)
+    Game* pregenerated = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        backend = preloadedBackend;
+        pregenerated = preloadedGame;
+        preloadedBackend = nullptr;
+        preloadedGame = nullptr;
+    }
+    if (backend != nullptr && rendererName != backend->getName()) {
+        startupReport.addNote(std::string("preloaded ") + backend->getName() + " but " + rendererName +
+                              " was requested");
+        delete backend;
+        backend = nullptr;
+    }
     
-    context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
-    eglMakeCurrent(display, surface, surface, context);
+    window = ANativeWindow_fromSurface(env, jSurface);
     
-    // Get screen dimensions
-    EGLint width, height;
-    eglQuerySurface(display, surface, EGL_WIDTH, &width);
-    eglQuerySurface(display, surface, EGL_HEIGHT, &height);
+    if (backend != nullptr && !backend->init(window, 0, 0, cacheDir)) {
+        delete backend;
+        backend = nullptr;
+    }
+    if (backend == nullptr) {
+        backend = createRenderBackend(rendererName);
+        if (backend == nullptr || !backend->init(window, 0, 0, cacheDir)) {
+            // Unknown or unsupported renderer: GLES2 always works
+            delete backend;
+            backend = createRenderBackend("gles2");
+            if (backend == nullptr || !backend->init(window, 0, 0, cacheDir)) {
+                delete pregenerated;
+                destroyRenderer();
+                return JNI_FALSE;
+            }
+        }
+    }
+    BallStyle ballStyle = defaultBallStyle();
+    bool ballStyleSupported = backend->setBallStyle(ballStyle);
+    ELOGI(EventId::BallStyleSet, static_cast<int>(ballStyle), ballStyleSupported ? 1 : 0);
+    startupReport.end(STARTUP_RENDERER_ATTACH);
     
-    // Initialize game
-    game = new Game();
+    // Round 1 was laid out for the predicted view size; keep it if the
+    // surface came out that size
+    startupReport.begin(STARTUP_GAME_READY);
+    if (pregenerated != nullptr && pregenerated->getScreenWidth() == backend->getWidth() &&
+        pregenerated->getScreenHeight() == backend->getHeight()) {
+        game = pregenerated;
+    } else {
+        if (pregenerated != nullptr) {
+            char note[128];
+            snprintf(note, sizeof(note), "round 1 regenerated: surface %dx%d, predicted %dx%d",
+                     backend->getWidth(), backend->getHeight(),
+                     pregenerated->getScreenWidth(), pregenerated->getScreenHeight());
+            startupReport.addNote(note);
+            delete pregenerated;
+        }
+        game = new Game();
+        game->setLevelTable(levelTable.isLoaded() ? &levelTable : nullptr);
+        game->init(backend->getWidth(), backend->getHeight());
+    }
     game->setToastCallback(showToast);
-    game->init(width, height);
+    ParticleMode particleMode = defaultParticleMode();
+    bool particleModeSupported = backend->supportsParticleMode(particleMode);
+    game->setParticleMode(particleModeSupported ? particleMode : PARTICLE_MODE_CPU);
+    ELOGI(EventId::ParticleModeSet, static_cast<int>(particleMode), particleModeSupported ? 1 : 0);
+    applyAutoplayProperty();
+    autoplayRunning = false;
+    startupReport.end(STARTUP_GAME_READY);
     
-    glViewport(0, 0, width, height);
+    latencyTracker.reset();
+    latencyTracker.setPresentTimesAvailable(backend->supportsPresentTimes());
     
     lastTime = std::chrono::high_resolution_clock::now();
+    firstFramePending = true;
     initialized = true;
+    return JNI_TRUE;
 }
 
 JNIEXPORT void JNICALL
 Java_com_rog3rb0t_touchgame_GameView_nativeRender(JNIEnv* env, jobject obj) {
-    if (!initialized || !game || display == EGL_NO_DISPLAY || surface == EGL_NO_SURFACE) return;
+    if (!initialized || !game || !backend) return;
     
-    if (eglMakeCurrent(display, surface, surface, context) == EGL_FALSE) {
+    if (!backend->makeCurrent()) {
         return;
     }
     
+    if (firstFramePending) {
+        startupReport.begin(STARTUP_FIRST_FRAME);
+    }
+    
+    latencyTracker.beginUpdate(monotonicNowNs());
+    
     auto currentTime = std::chrono::high_resolution_clock::now();
     float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
     lastTime = currentTime;
@@ -141,17 +401,53 @@ Java_com_rog3rb0t_touchgame_GameView_nativeRender(JNIEnv* env, jobject obj) {
     // Limit delta time to prevent large jumps
     if (deltaTime > 0.1f) deltaTime = 0.016f;
     
+    bool autoplay = autoplayEnabled;
+    if (autoplay != autoplayRunning) {
+        autoplayRunning = autoplay;
+        autoplayer.reset(static_cast<uint32_t>(monotonicNowNs()));
+        autoplayClock = 0.0f;
+        ELOGI(EventId::AutoplaySet, autoplay ? 1 : 0, game->getRound(),
+              autoplayer.getConfig().reactionTime * 1000.0f, autoplayer.getConfig().aimErrorPx);
+    }
+    if (autoplay) {
+        autoplayClock += deltaTime;
+        float x, y;
+        if (autoplayer.update(*game, autoplayClock, x, y)) {
+            dispatchTouch(x, y, monotonicNowNs());
+        }
+    }
+    
     game->update(deltaTime);
-    game->render();
+    game->render(*backend);
     
-    eglSwapBuffers(display, surface);
+    uint64_t frameId = 0;
+    bool hasFrameId = backend->nextFrameId(&frameId);
+    latencyTracker.submitFrame(monotonicNowNs(), frameId, hasFrameId);
+    
+    backend->present();
+    
+    if (firstFramePending) {
+        startupReport.end(STARTUP_FIRST_FRAME);
+        firstFramePending = false;
+    }
+    
+    pollPresentTimes();
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_rog3rb0t_touchgame_GameView_nativeTouch(JNIEnv* env, jobject obj, jfloat x, jfloat y) {
+Java_com_rog3rb0t_touchgame_GameView_nativeTouch(JNIEnv* env, jobject obj, jfloat x, jfloat y,
+                                                 jlong eventTimeNanos) {
     if (!initialized || !game) return JNI_FALSE;
     
-    return game->handleTouch(x, y) ? JNI_TRUE : JNI_FALSE;
+    return dispatchTouch(x, y, eventTimeNanos) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Returns the new state
+JNIEXPORT jboolean JNICALL
+Java_com_rog3rb0t_touchgame_GameView_nativeToggleAutoplay(JNIEnv* env, jobject obj) {
+    bool enabled = !autoplayEnabled;
+    autoplayEnabled = enabled;
+    return enabled ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jint JNICALL
@@ -215,36 +511,37 @@ Java_com_rog3rb0t_touchgame_GameView_nativeGetBgColorB2(JNIEnv* env, jobject obj
     return game->getBgColorB2();
 }
 
+JNIEXPORT jstring JNICALL
+Java_com_rog3rb0t_touchgame_GameView_nativeDumpEventLog(JNIEnv* env, jobject obj) {
+    return env->NewStringUTF(eventlog::dump().c_str());
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_rog3rb0t_touchgame_GameView_nativeGetLatencyStats(JNIEnv* env, jobject obj) {
+    std::vector<int64_t> values = latencyTracker.snapshot();
+    jlongArray result = env->NewLongArray(static_cast<jsize>(values.size()));
+    if (result != nullptr) {
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(values.size()),
+                                reinterpret_cast<const jlong*>(values.data()));
+    }
+    return result;
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_rog3rb0t_touchgame_GameView_nativeGetLatencyReport(JNIEnv* env, jobject obj) {
+    return env->NewStringUTF(latencyTracker.report().c_str());
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_rog3rb0t_touchgame_GameView_nativeGetRendererName(JNIEnv* env, jobject obj) {
+    return env->NewStringUTF(backend ? backend->getName() : "");
+}
+
 JNIEXPORT void JNICALL
 Java_com_rog3rb0t_touchgame_GameView_nativeDestroy(JNIEnv* env, jobject obj) {
-    if (game) {
-        delete game;
-        game = nullptr;
-    }
-    
-    if (display != EGL_NO_DISPLAY) {
-        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
-        
-        if (context != EGL_NO_CONTEXT) {
-            eglDestroyContext(display, context);
-            context = EGL_NO_CONTEXT;
-        }
-        
-        if (surface != EGL_NO_SURFACE) {
-            eglDestroySurface(display, surface);
-            surface = EGL_NO_SURFACE;
-        }
-        
-        eglTerminate(display);
-        display = EGL_NO_DISPLAY;
-    }
-    
-    if (window) {
-        ANativeWindow_release(window);
-        window = nullptr;
-    }
-    
     initialized = false;
+    destroyRenderer();
+    latencyTracker.setPresentTimesAvailable(false);
 }
 
 } // extern "C"
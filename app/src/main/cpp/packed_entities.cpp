@@ -0,0 +1,149 @@
+#include "packed_entities.h"
+#include "game.h"
+#include <algorithm>
+
+// Units per second of lifetime / flash, per pixel of size / radius.
+// 3840 makes 30, 60 and 120 Hz steps whole numbers.
+static const float LIFETIME_UNITS = 3840.0f;
+static const float MAX_LIFETIME_UNITS = 64.0f;
+static const float SIZE_UNITS = 2.0f;
+static const float RADIUS_UNITS = 16.0f;
+static const float FLASH_UNITS = 16384.0f;
+// Fixed-point position units covered per velocity unit and second
+static const float STEP_SCALE = PACKED_POSITION_UNITS / PACKED_VELOCITY_UNITS;
+
+// Nearest value, saturated; -32768 is left out so the range is symmetric
+// as a normalized attribute. Offset to positive so truncation rounds,
+// without a branch or a libm call.
+static inline int16_t toInt16(float value) {
+    value = std::max(-32767.0f, std::min(value, 32767.0f));
+    return static_cast<int16_t>(static_cast<int32_t>(value + 32768.5f) - 32768);
+}
+
+static inline uint16_t toUint16(float value) {
+    return static_cast<uint16_t>(std::max(0.0f, std::min(value, 65535.0f)) + 0.5f);
+}
+
+static inline uint8_t toUint8(float value) {
+    return static_cast<uint8_t>(std::max(0.0f, std::min(value, 255.0f)) + 0.5f);
+}
+
+PackedParticle packParticle(const Particle& particle, int screenWidth, int screenHeight) {
+    PackedParticle packed;
+    packed.x = toInt16(particle.x * PACKED_POSITION_UNITS / screenWidth);
+    packed.y = toInt16(particle.y * PACKED_POSITION_UNITS / screenHeight);
+    packed.velocityX = toInt16(particle.velocityX * PACKED_VELOCITY_UNITS / screenWidth);
+    packed.velocityY = toInt16(particle.velocityY * PACKED_VELOCITY_UNITS / screenHeight);
+    packed.color[0] = toUint8(particle.colorR * 255.0f);
+    packed.color[1] = toUint8(particle.colorG * 255.0f);
+    packed.color[2] = toUint8(particle.colorB * 255.0f);
+    packed.color[3] = toUint8((1.0f - particle.lifetime / particle.maxLifetime) * 255.0f);
+    packed.lifetime = toUint16(particle.lifetime * LIFETIME_UNITS);
+    packed.maxLifetime = toUint8(particle.maxLifetime * MAX_LIFETIME_UNITS);
+    packed.size = toUint8(particle.size * SIZE_UNITS);
+    return packed;
+}
+
+Particle unpackParticle(const PackedParticle& packed, int screenWidth, int screenHeight) {
+    Particle particle;
+    particle.x = packed.x * screenWidth / PACKED_POSITION_UNITS;
+    particle.y = packed.y * screenHeight / PACKED_POSITION_UNITS;
+    particle.velocityX = packed.velocityX * screenWidth / PACKED_VELOCITY_UNITS;
+    particle.velocityY = packed.velocityY * screenHeight / PACKED_VELOCITY_UNITS;
+    particle.size = packed.size / SIZE_UNITS;
+    particle.colorR = packed.color[0] / 255.0f;
+    particle.colorG = packed.color[1] / 255.0f;
+    particle.colorB = packed.color[2] / 255.0f;
+    particle.lifetime = packed.lifetime / LIFETIME_UNITS;
+    particle.maxLifetime = packed.maxLifetime / MAX_LIFETIME_UNITS;
+    return particle;
+}
+
+PackedCircle packCircle(const Circle& circle, int screenWidth, int screenHeight) {
+    PackedCircle packed;
+    packed.x = toInt16(circle.x * PACKED_POSITION_UNITS / screenWidth);
+    packed.y = toInt16(circle.y * PACKED_POSITION_UNITS / screenHeight);
+    packed.velocityX = toInt16(circle.velocityX * PACKED_VELOCITY_UNITS / screenWidth);
+    packed.velocityY = toInt16(circle.velocityY * PACKED_VELOCITY_UNITS / screenHeight);
+    packed.color[0] = toUint8(circle.colorR * 255.0f);
+    packed.color[1] = toUint8(circle.colorG * 255.0f);
+    packed.color[2] = toUint8(circle.colorB * 255.0f);
+    packed.color[3] = 255;
+    packed.radius = toUint16(circle.radius * RADIUS_UNITS);
+    packed.flashTimer = toUint16(circle.flashTimer * FLASH_UNITS);
+    return packed;
+}
+
+Circle unpackCircle(const PackedCircle& packed, int screenWidth, int screenHeight) {
+    Circle circle;
+    circle.x = packed.x * screenWidth / PACKED_POSITION_UNITS;
+    circle.y = packed.y * screenHeight / PACKED_POSITION_UNITS;
+    circle.radius = packed.radius / RADIUS_UNITS;
+    circle.velocityX = packed.velocityX * screenWidth / PACKED_VELOCITY_UNITS;
+    circle.velocityY = packed.velocityY * screenHeight / PACKED_VELOCITY_UNITS;
+    circle.colorR = packed.color[0] / 255.0f;
+    circle.colorG = packed.color[1] / 255.0f;
+    circle.colorB = packed.color[2] / 255.0f;
+    circle.flashTimer = packed.flashTimer / FLASH_UNITS;
+    return circle;
+}
+
+void updatePackedParticles(std::vector<PackedParticle>& particles, float deltaTime, float gravity,
+                           int screenHeight) {
+    // Everything in fixed-point units, as floats while stepping
+    const float step = deltaTime * STEP_SCALE;
+    const uint16_t lifetimeStep = toUint16(deltaTime * LIFETIME_UNITS);
+    const float maxLifetimeScale = LIFETIME_UNITS / MAX_LIFETIME_UNITS;
+    // Velocity units gained per lifetime unit. Gravity is added as the
+    // difference of the rounded totals at the old and new age, so rounding
+    // never accumulates into the velocity.
+    const float gravityPerLifetime = gravity * PACKED_VELOCITY_UNITS / (screenHeight * LIFETIME_UNITS);
+
+    size_t alive = 0;
+    for (size_t i = 0; i < particles.size(); i++) {
+        PackedParticle particle = particles[i];
+        uint32_t lifetime = particle.lifetime + lifetimeStep;
+        float maxLifetime = particle.maxLifetime * maxLifetimeScale;
+        if (lifetime >= maxLifetime || lifetime > 65535) continue;
+
+        float velocityY = particle.velocityY;
+        float gravityBefore = static_cast<int32_t>(particle.lifetime * gravityPerLifetime + 0.5f);
+        float gravityAfter = static_cast<int32_t>(lifetime * gravityPerLifetime + 0.5f);
+        particle.x = toInt16(particle.x + particle.velocityX * step);
+        particle.y = toInt16(particle.y + velocityY * step);
+        particle.velocityY = toInt16(velocityY + (gravityAfter - gravityBefore));
+        particle.lifetime = static_cast<uint16_t>(lifetime);
+        particle.color[3] = toUint8((1.0f - lifetime / maxLifetime) * 255.0f);
+        particles[alive++] = particle;
+    }
+    particles.resize(alive);
+}
+
+void updatePackedCircles(std::vector<PackedCircle>& circles, float deltaTime, int screenWidth,
+                         int screenHeight) {
+    const float step = deltaTime * STEP_SCALE;
+    const float flashStep = deltaTime * FLASH_UNITS;
+    // Radius (1/16 px) to position units on each axis
+    const float radiusScaleX = PACKED_POSITION_UNITS / (RADIUS_UNITS * screenWidth);
+    const float radiusScaleY = PACKED_POSITION_UNITS / (RADIUS_UNITS * screenHeight);
+
+    for (PackedCircle& circle : circles) {
+        float x = circle.x + circle.velocityX * step;
+        float y = circle.y + circle.velocityY * step;
+        circle.flashTimer = toUint16(circle.flashTimer - flashStep);
+
+        // Bounce off walls
+        float radiusX = circle.radius * radiusScaleX;
+        float radiusY = circle.radius * radiusScaleY;
+        if (x - radiusX < 0.0f || x + radiusX > PACKED_POSITION_UNITS) {
+            circle.velocityX = -circle.velocityX;
+            x = std::max(radiusX, std::min(x, PACKED_POSITION_UNITS - radiusX));
+        }
+        if (y - radiusY < 0.0f || y + radiusY > PACKED_POSITION_UNITS) {
+            circle.velocityY = -circle.velocityY;
+            y = std::max(radiusY, std::min(y, PACKED_POSITION_UNITS - radiusY));
+        }
+        circle.x = toInt16(x);
+        circle.y = toInt16(y);
+    }
+}
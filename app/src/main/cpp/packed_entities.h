@@ -0,0 +1,64 @@
+#ifndef TOUCHGAME_PACKED_ENTITIES_H
+#define TOUCHGAME_PACKED_ENTITIES_H
+
+#include <cstdint>
+#include <vector>
+
+struct Circle;
+struct Particle;
+
+// Quantized 16-byte layouts for large entity counts, in place of the float
+// structs (Circle 36 bytes, Particle 40 bytes).
+//
+// Positions are 16-bit fixed point relative to the screen: 16384 units per
+// screen width (x) or height (y), covering +/-2 screens in 0.07 px (x) and
+// 0.12 px (y) steps on a 1080x1920 display. Velocities use 4096 units per screen per second
+// (+/-8 screens/s). Colors are RGBA8 and timers are 8 or 16-bit fixed
+// point. The update kernels unpack to floats, step, and pack again, so
+// the arrays stay packed in memory. A PackedParticle is also a vertex: the
+// renderer uploads the array as is and reads position, color and size as
+// normalized attributes.
+struct PackedParticle {
+    int16_t x;
+    int16_t y;
+    int16_t velocityX;
+    int16_t velocityY;
+    uint8_t color[4];       // RGBA8; alpha is the fade, kept current by the update
+    uint16_t lifetime;      // seconds * 3840 (17 s)
+    uint8_t maxLifetime;    // seconds * 64, up to PACKED_MAX_LIFETIME
+    uint8_t size;           // pixels * 2, up to PACKED_MAX_SIZE
+};
+
+struct PackedCircle {
+    int16_t x;
+    int16_t y;
+    int16_t velocityX;
+    int16_t velocityY;
+    uint8_t color[4];       // RGBA8, alpha opaque
+    uint16_t radius;        // pixels * 16 (4096 px)
+    uint16_t flashTimer;    // seconds * 16384 (4 s), 0 when not flashing
+};
+
+static_assert(sizeof(PackedParticle) == 16, "PackedParticle is a 16-byte vertex");
+static_assert(sizeof(PackedCircle) == 16, "PackedCircle is 16 bytes");
+
+const float PACKED_POSITION_UNITS = 16384.0f;   // per screen
+const float PACKED_VELOCITY_UNITS = 4096.0f;    // per screen per second
+
+// Largest particle lifetime and size the 8-bit fields hold; packParticle()
+// saturates past them, so touchgame_levelc rejects effects that exceed them
+const float PACKED_MAX_LIFETIME = 255.0f / 64.0f;   // seconds
+const float PACKED_MAX_SIZE = 255.0f / 2.0f;        // pixels
+
+PackedParticle packParticle(const Particle& particle, int screenWidth, int screenHeight);
+Particle unpackParticle(const PackedParticle& packed, int screenWidth, int screenHeight);
+PackedCircle packCircle(const Circle& circle, int screenWidth, int screenHeight);
+Circle unpackCircle(const PackedCircle& packed, int screenWidth, int screenHeight);
+
+// Same steps as updateParticles() and updateCircles(), on packed storage
+void updatePackedParticles(std::vector<PackedParticle>& particles, float deltaTime, float gravity,
+                           int screenHeight);
+void updatePackedCircles(std::vector<PackedCircle>& circles, float deltaTime, int screenWidth,
+                         int screenHeight);
+
+#endif // TOUCHGAME_PACKED_ENTITIES_H
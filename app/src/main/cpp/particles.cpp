@@ -0,0 +1,83 @@
+#include "particles.h"
+
+ParticleSpawnRing::ParticleSpawnRing() : slots(INITIAL_CAPACITY), tail(0), count(0), dropped(0) {
+}
+
+ParticleSpawn& ParticleSpawnRing::spawn() {
+    if (count == slots.size()) {
+        if (slots.size() < MAX_CAPACITY) {
+            // Unroll into a ring twice the size, oldest at the front
+            std::vector<ParticleSpawn> grown(slots.size() * 2);
+            for (size_t i = 0; i < count; i++) {
+                grown[i] = (*this)[i];
+            }
+            slots.swap(grown);
+            tail = 0;
+        } else {
+            tail = (tail + 1) & (slots.size() - 1);
+            count--;
+            dropped++;
+        }
+    }
+    ParticleSpawn& slot = slots[(tail + count) & (slots.size() - 1)];
+    count++;
+    return slot;
+}
+
+void ParticleSpawnRing::retire(float time) {
+    while (count > 0) {
+        const ParticleSpawn& oldest = slots[tail];
+        if (time - oldest.spawnTime < oldest.lifetimeMax) break;
+        tail = (tail + 1) & (slots.size() - 1);
+        count--;
+    }
+}
+
+void ParticleSpawnRing::rebase(float offset) {
+    for (size_t i = 0; i < count; i++) {
+        slots[(tail + i) & (slots.size() - 1)].spawnTime -= offset;
+    }
+}
+
+void ParticleSpawnRing::clear() {
+    tail = 0;
+    count = 0;
+}
+
+void updateParticles(std::vector<Particle>& particles, float deltaTime, float gravity) {
+    // Compacts survivors towards the front in one pass
+    size_t alive = 0;
+    for (size_t i = 0; i < particles.size(); i++) {
+        Particle& particle = particles[i];
+        particle.x += particle.velocityX * deltaTime;
+        particle.y += particle.velocityY * deltaTime;
+        particle.velocityY += gravity * deltaTime;
+        particle.lifetime += deltaTime;
+
+        if (particle.lifetime < particle.maxLifetime) {
+            particles[alive++] = particle;
+        }
+    }
+    particles.resize(alive);
+}
+
+bool parseParticleMode(const std::string& name, ParticleMode* mode) {
+    if (name == "cpu") {
+        *mode = PARTICLE_MODE_CPU;
+    } else if (name == "gpu") {
+        *mode = PARTICLE_MODE_GPU;
+    } else if (name == "packed") {
+        *mode = PARTICLE_MODE_PACKED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* particleModeName(ParticleMode mode) {
+    switch (mode) {
+        case PARTICLE_MODE_GPU: return "gpu";
+        case PARTICLE_MODE_PACKED: return "packed";
+        default: return "cpu";
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef TOUCHGAME_PARTICLES_H
+#define TOUCHGAME_PARTICLES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Explosion particles come in three forms:
+//
+// CPU: every particle is a Particle, integrated each tick by
+// updateParticles() and uploaded as vertices; cost grows with the count.
+//
+// PACKED: as CPU, but each particle is a 16-byte PackedParticle
+// (packed_entities.h) that is stepped in place by updatePackedParticles()
+// and uploaded unchanged as one point-sprite vertex.
+//
+// GPU: an explosion is one ParticleSpawn record. The renderer's vertex
+// shader derives each particle's direction, speed, size, color and lifetime
+// from (seed, particle index) with a hash and evaluates its position and
+// fade in closed form from the age, so nothing is stored or updated per
+// particle.
+//
+// Backends other than gles2 only draw CPU particles, see
+// RenderBackend::supportsParticleMode().
+enum ParticleMode {
+    PARTICLE_MODE_CPU = 0,
+    PARTICLE_MODE_GPU,
+    PARTICLE_MODE_PACKED
+};
+
+struct Particle {
+    float x;
+    float y;
+    float velocityX;
+    float velocityY;
+    float size;
+    float colorR;
+    float colorG;
+    float colorB;
+    float lifetime; // seconds
+    float maxLifetime;
+};
+
+// One explosion in GPU mode. The fields are ordered as the four vec4
+// uniforms the shader reads; ranges are sampled uniformly per particle,
+// as Game::createExplosion does in CPU mode.
+struct ParticleSpawn {
+    float x;                // origin, pixels
+    float y;
+    float spawnTime;        // seconds, on the clock passed to retire()
+    float seed;             // whole number 0-65535, exact in a shader float
+    float colorR;
+    float colorG;
+    float colorB;
+    float colorJitter;      // +/- half this per channel
+    float sizeMin;          // pixels
+    float sizeMax;
+    float speedMin;         // px/s
+    float speedMax;
+    float upwardBias;       // px/s subtracted from the initial y velocity
+    float gravity;          // px/s^2
+    float lifetimeMin;      // seconds
+    float lifetimeMax;
+    uint32_t count;         // particles
+};
+
+// Live spawn records, oldest first, in a ring that recycles a record's slot
+// once its longest-lived particle has faded. Records expire roughly in
+// spawn order; one outliving its successors only delays their reuse.
+// The ring doubles when full and, at MAX_CAPACITY, overwrites the oldest.
+class ParticleSpawnRing {
+public:
+    static const size_t INITIAL_CAPACITY = 64;
+    static const size_t MAX_CAPACITY = 16384;
+
+    ParticleSpawnRing();
+
+    // A slot for a new record, to be filled in by the caller
+    ParticleSpawn& spawn();
+    // Frees the records that have fully faded by `time`
+    void retire(float time);
+    // Moves every live record's spawn time `offset` seconds earlier, for a
+    // clock that is moved back by the same amount
+    void rebase(float offset);
+    void clear();
+
+    size_t size() const { return count; }
+    // Oldest first
+    const ParticleSpawn& operator[](size_t index) const { return slots[(tail + index) & (slots.size() - 1)]; }
+    // Records overwritten while still visible
+    uint64_t getDropped() const { return dropped; }
+
+private:
+    std::vector<ParticleSpawn> slots; // power-of-two size
+    size_t tail;                      // oldest record
+    size_t count;
+    uint64_t dropped;
+};
+
+// CPU mode: moves every particle one step under gravity and removes the
+// ones whose lifetime is over, keeping the others in order
+void updateParticles(std::vector<Particle>& particles, float deltaTime, float gravity);
+
+// "cpu", "gpu" or "packed"; false for anything else
+bool parseParticleMode(const std::string& name, ParticleMode* mode);
+const char* particleModeName(ParticleMode mode);
+
+#endif // TOUCHGAME_PARTICLES_H
@@ -0,0 +1,38 @@
+#include "render_backend.h"
+
+#ifdef TOUCHGAME_HAS_GLES
+#include "gles_backend.h"
+#endif
+
+RenderBackend* createRenderBackend(const std::string& name) {
+#ifdef TOUCHGAME_HAS_GLES
+    if (name == "gles2") {
+        return new GlesBackend();
+    }
+#endif
+    (void)name;
+    return nullptr;
+}
+
+std::vector<std::string> availableRenderBackends() {
+    std::vector<std::string> names;
+#ifdef TOUCHGAME_HAS_GLES
+    names.push_back("gles2");
+#endif
+    return names;
+}
+
+bool parseBallStyle(const std::string& name, BallStyle* style) {
+    if (name == "mesh") {
+        *style = BALL_STYLE_MESH;
+    } else if (name == "impostor") {
+        *style = BALL_STYLE_IMPOSTOR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ballStyleName(BallStyle style) {
+    return style == BALL_STYLE_IMPOSTOR ? "impostor" : "mesh";
+}
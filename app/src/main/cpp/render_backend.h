@@ -0,0 +1,104 @@
+#ifndef TOUCHGAME_RENDER_BACKEND_H
+#define TOUCHGAME_RENDER_BACKEND_H
+
+#include "particles.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Circle;
+struct PackedParticle;
+class Hud;
+
+// Everything a renderer needs to draw one frame. Coordinates are screen
+// pixels with the origin at the top left, as used by the game simulation.
+struct FrameData {
+    int screenWidth;
+    int screenHeight;
+    float bgColor1[3]; // gradient bottom
+    float bgColor2[3]; // gradient top
+    const std::vector<Circle>* circles;
+    const std::vector<Particle>* particles;
+    // Packed particle mode; empty or null otherwise
+    const std::vector<PackedParticle>* packedParticles;
+    // GPU particle mode: explosions to evaluate in the vertex shader at
+    // particleTime. Empty or null otherwise.
+    const ParticleSpawnRing* particleSpawns;
+    float particleTime;
+    const Hud* hud;
+};
+
+// How balls are drawn. MESH tessellates 24 shaded rings plus a highlight
+// fan (~2.4k vertices per ball); IMPOSTOR draws one quad per ball and
+// shades the sphere per fragment, trading vertex load for fill rate.
+enum BallStyle {
+    BALL_STYLE_MESH = 0,
+    BALL_STYLE_IMPOSTOR
+};
+
+enum PresentTimeStatus {
+    PRESENT_TIME_PENDING,
+    PRESENT_TIME_AVAILABLE,
+    PRESENT_TIME_UNKNOWN
+};
+
+// A rendering API plus the surface it presents to. The Game core only ever
+// draws through this interface; backends are chosen at runtime by name.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    virtual const char* getName() const = 0;
+
+    // nativeWindow is an ANativeWindow on Android. nullptr renders offscreen
+    // at width x height (host benchmarks, CI).
+    virtual bool init(void* nativeWindow, int width, int height, const std::string& cacheDir) = 0;
+    // Optional first half of init() that needs no window: device/context,
+    // shader programs, static buffers and textures. It may run on another
+    // thread (during the splash screen) and leaves nothing bound to it; a
+    // later init() then only attaches the window. Backends that can't split
+    // their setup return false and do everything in init().
+    virtual bool preload(const std::string& cacheDir) { (void)cacheDir; return false; }
+    virtual int getWidth() const = 0;
+    virtual int getHeight() const = 0;
+
+    // Binds the backend to the calling thread; GL needs this every frame
+    virtual bool makeCurrent() { return true; }
+    virtual void drawFrame(const FrameData& frame) = 0;
+    virtual void present() = 0;
+    // Blocks until the GPU has finished all submitted work
+    virtual void finish() = 0;
+
+    // May be called at any time, before or after init(). Returns false and
+    // keeps drawing meshes if the backend lacks the style.
+    virtual bool setBallStyle(BallStyle style) { return style == BALL_STYLE_MESH; }
+    virtual BallStyle getBallStyle() const { return BALL_STYLE_MESH; }
+
+    // Whether drawFrame() renders the FrameData field the mode fills in;
+    // the game only switches to modes the backend supports
+    virtual bool supportsParticleMode(ParticleMode mode) const { return mode == PARTICLE_MODE_CPU; }
+
+    // Display timing, for latency measurement. nextFrameId() is called
+    // before present() for the frame being submitted.
+    virtual bool supportsPresentTimes() const { return false; }
+    virtual bool nextFrameId(uint64_t* frameId) { (void)frameId; return false; }
+    virtual PresentTimeStatus queryPresentTime(uint64_t frameId, int64_t* presentNs) {
+        (void)frameId;
+        (void)presentNs;
+        return PRESENT_TIME_UNKNOWN;
+    }
+
+    // Backend-specific counters for benchmarks and logs; empty if none
+    virtual std::string getStatsReport() const { return ""; }
+    virtual void resetStats() {}
+};
+
+// "gles2"; returns nullptr for backends not compiled in
+RenderBackend* createRenderBackend(const std::string& name);
+std::vector<std::string> availableRenderBackends();
+
+// "mesh" or "impostor"; false for anything else
+bool parseBallStyle(const std::string& name, BallStyle* style);
+const char* ballStyleName(BallStyle style);
+
+#endif // TOUCHGAME_RENDER_BACKEND_H
@@ -0,0 +1,184 @@
+#include "sdf_font.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// 5x7 pixel font, one byte per row, bit 4 = leftmost column
+struct BitmapGlyph {
+    char character;
+    uint8_t rows[7];
+};
+
+const BitmapGlyph kBitmapFont[] = {
+    {' ', {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+    {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+    {'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},
+    {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+    {'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},
+    {'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+    {'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},
+    {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+    {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},
+    {':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+    {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+    {'D', {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},
+    {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+    {'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},
+    {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+    {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+    {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+};
+
+const int kGlyphCount = sizeof(kBitmapFont) / sizeof(kBitmapFont[0]);
+static_assert(SdfFont::ATLAS_COLUMNS * SdfFont::CELL_WIDTH <= SdfFont::ATLAS_WIDTH &&
+              (kGlyphCount + SdfFont::ATLAS_COLUMNS - 1) / SdfFont::ATLAS_COLUMNS * SdfFont::CELL_HEIGHT
+                  <= SdfFont::ATLAS_HEIGHT,
+              "glyph cells must fit in the atlas");
+const int kFontColumns = 5;
+const int kFontRows = 7;
+const int kTexelsPerPixel = 4;
+const int kMarginX = (SdfFont::CELL_WIDTH - kFontColumns * kTexelsPerPixel) / 2;
+const int kMarginY = (SdfFont::CELL_HEIGHT - kFontRows * kTexelsPerPixel) / 2;
+
+// Bump whenever the font or the generator changes so caches are rebuilt
+const uint32_t kCacheVersion = 1;
+const char kCacheMagic[4] = {'T', 'G', 'S', 'D'};
+
+bool pixelSet(const BitmapGlyph& glyph, int column, int row) {
+    if (column < 0 || column >= kFontColumns || row < 0 || row >= kFontRows) return false;
+    return (glyph.rows[row] >> (kFontColumns - 1 - column)) & 1;
+}
+
+// Distance from (x, y) to the font pixel square at (column, row)
+float distanceToPixel(float x, float y, int column, int row) {
+    float half = kTexelsPerPixel * 0.5f;
+    float cx = kMarginX + column * kTexelsPerPixel + half;
+    float cy = kMarginY + row * kTexelsPerPixel + half;
+    float dx = std::max(std::fabs(x - cx) - half, 0.0f);
+    float dy = std::max(std::fabs(y - cy) - half, 0.0f);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+struct GlyphTable {
+    GlyphInfo glyphs[kGlyphCount];
+
+    GlyphTable() {
+        for (int g = 0; g < kGlyphCount; g++) {
+            int originX = (g % SdfFont::ATLAS_COLUMNS) * SdfFont::CELL_WIDTH;
+            int originY = (g / SdfFont::ATLAS_COLUMNS) * SdfFont::CELL_HEIGHT;
+            GlyphInfo& info = glyphs[g];
+            info.character = kBitmapFont[g].character;
+            info.u0 = static_cast<float>(originX) / SdfFont::ATLAS_WIDTH;
+            info.v0 = static_cast<float>(originY) / SdfFont::ATLAS_HEIGHT;
+            info.u1 = static_cast<float>(originX + SdfFont::CELL_WIDTH) / SdfFont::ATLAS_WIDTH;
+            info.v1 = static_cast<float>(originY + SdfFont::CELL_HEIGHT) / SdfFont::ATLAS_HEIGHT;
+        }
+    }
+};
+
+const GlyphTable kGlyphTable;
+
+} // namespace
+
+bool SdfFont::load(const std::string& cacheDir) {
+    std::string path = cacheDir.empty() ? std::string() : cacheDir + "/hud_font.sdf";
+
+    if (!path.empty() && readCache(path)) {
+        return true;
+    }
+
+    generate();
+    if (!path.empty()) {
+        writeCache(path); // a failed write only costs regeneration next launch
+    }
+    return true;
+}
+
+const GlyphInfo* SdfFont::glyph(char c) {
+    for (const auto& info : kGlyphTable.glyphs) {
+        if (info.character == c) return &info;
+    }
+    return nullptr;
+}
+
+void SdfFont::generate() {
+    pixels.assign(ATLAS_WIDTH * ATLAS_HEIGHT, 0);
+
+    for (int g = 0; g < kGlyphCount; g++) {
+        const BitmapGlyph& glyph = kBitmapFont[g];
+        int originX = (g % ATLAS_COLUMNS) * CELL_WIDTH;
+        int originY = (g / ATLAS_COLUMNS) * CELL_HEIGHT;
+
+        for (int ty = 0; ty < CELL_HEIGHT; ty++) {
+            for (int tx = 0; tx < CELL_WIDTH; tx++) {
+                float x = tx + 0.5f;
+                float y = ty + 0.5f;
+
+                // Nearest lit pixel (outside distance) and nearest unlit
+                // pixel or grid border (inside distance)
+                float toSet = INFINITY;
+                float toUnset = INFINITY;
+                for (int row = 0; row < kFontRows; row++) {
+                    for (int column = 0; column < kFontColumns; column++) {
+                        float d = distanceToPixel(x, y, column, row);
+                        if (pixelSet(glyph, column, row)) {
+                            toSet = std::min(toSet, d);
+                        } else {
+                            toUnset = std::min(toUnset, d);
+                        }
+                    }
+                }
+                float gridLeft = x - kMarginX;
+                float gridRight = kMarginX + kFontColumns * kTexelsPerPixel - x;
+                float gridTop = y - kMarginY;
+                float gridBottom = kMarginY + kFontRows * kTexelsPerPixel - y;
+                float toBorder = std::min(std::min(gridLeft, gridRight), std::min(gridTop, gridBottom));
+                toUnset = std::min(toUnset, std::max(toBorder, 0.0f));
+
+                float signedDistance = toSet > 0.0f ? -toSet : toUnset;
+                float value = 0.5f + signedDistance / (2.0f * SPREAD);
+                value = std::max(0.0f, std::min(1.0f, value));
+                pixels[(originY + ty) * ATLAS_WIDTH + originX + tx] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+            }
+        }
+    }
+}
+
+bool SdfFont::readCache(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char magic[4];
+    uint32_t header[3]; // version, width, height
+    bool ok = fread(magic, 1, 4, file) == 4 &&
+              memcmp(magic, kCacheMagic, 4) == 0 &&
+              fread(header, sizeof(uint32_t), 3, file) == 3 &&
+              header[0] == kCacheVersion &&
+              header[1] == ATLAS_WIDTH && header[2] == ATLAS_HEIGHT;
+    if (ok) {
+        pixels.resize(ATLAS_WIDTH * ATLAS_HEIGHT);
+        ok = fread(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    }
+    fclose(file);
+    return ok;
+}
+
+bool SdfFont::writeCache(const std::string& path) const {
+    // Write to a temporary name and rename so a crash can't leave a torn file
+    std::string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (!file) return false;
+
+    uint32_t header[3] = {kCacheVersion, ATLAS_WIDTH, ATLAS_HEIGHT};
+    bool ok = fwrite(kCacheMagic, 1, 4, file) == 4 &&
+              fwrite(header, sizeof(uint32_t), 3, file) == 3 &&
+              fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    ok = fclose(file) == 0 && ok;
+    return ok && rename(tempPath.c_str(), path.c_str()) == 0;
+}
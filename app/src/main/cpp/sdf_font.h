@@ -0,0 +1,54 @@
+#ifndef TOUCHGAME_SDF_FONT_H
+#define TOUCHGAME_SDF_FONT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Signed-distance-field glyph atlas for the in-engine HUD.
+//
+// Glyphs come from a small built-in 5x7 pixel font. The distance field is
+// computed on first launch and cached on disk so later launches only read
+// the file. Each texel stores 0.5 at the glyph edge, rising inside.
+
+struct GlyphInfo {
+    char character;
+    float u0, v0, u1, v1; // atlas texture coordinates
+};
+
+class SdfFont {
+public:
+    static const int CELL_WIDTH = 32;   // texels per glyph cell
+    static const int CELL_HEIGHT = 40;
+    static const int ATLAS_COLUMNS = 8;
+    static const int ATLAS_WIDTH = 256;   // fits ATLAS_COLUMNS cells
+    static const int ATLAS_HEIGHT = 128;  // fits every row of cells
+    static const int GLYPH_ADVANCE = 24;  // texels between glyph origins
+    static constexpr float SPREAD = 6.0f; // texels from the edge to 0 or 1
+
+    SdfFont() {}
+
+    // Loads the atlas from cacheDir, generating and saving it if missing or
+    // stale. An empty cacheDir just generates it in memory.
+    bool load(const std::string& cacheDir);
+
+    // The atlas layout is fixed, so glyph lookup works without the pixels
+    // (the HUD lays out text before any renderer has loaded the atlas)
+    static const GlyphInfo* glyph(char c);
+
+    // Glyph quad size relative to the cell, for layout
+    static float glyphAspect() { return static_cast<float>(CELL_WIDTH) / CELL_HEIGHT; }
+
+    int getWidth() const { return ATLAS_WIDTH; }
+    int getHeight() const { return ATLAS_HEIGHT; }
+    const std::vector<uint8_t>& getPixels() const { return pixels; }
+
+private:
+    void generate();
+    bool readCache(const std::string& path);
+    bool writeCache(const std::string& path) const;
+
+    std::vector<uint8_t> pixels;
+};
+
+#endif // TOUCHGAME_SDF_FONT_H
@@ -0,0 +1,132 @@
+#include "startup.h"
+#include "latency.h"
+#include <cstdio>
+
+static const char* const kPhaseNames[STARTUP_PHASE_COUNT] = {
+    "process start",
+    "splash created",
+    "library load",
+    "levels map",
+    "renderer preload",
+    "round pregenerate",
+    "game activity",
+    "surface created",
+    "preload wait",
+    "renderer attach",
+    "game ready",
+    "first frame",
+};
+
+// Work that runs on the preload thread, off the critical path when it
+// finishes before the surface exists
+static const StartupPhase kPreloadPhases[] = {
+    STARTUP_LIBRARY_LOAD,
+    STARTUP_LEVELS_MAP,
+    STARTUP_RENDERER_PRELOAD,
+    STARTUP_ROUND_PREGENERATE,
+};
+
+// Later surface re-creations go through the same code; only the cold
+// start is kept
+bool StartupReport::isComplete() const {
+    return spans[STARTUP_FIRST_FRAME].endNs != 0;
+}
+
+void StartupReport::begin(StartupPhase phase) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isComplete()) return;
+    spans[phase].beginNs = monotonicNowNs();
+    spans[phase].endNs = 0;
+}
+
+void StartupReport::end(StartupPhase phase) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isComplete()) return;
+    spans[phase].endNs = monotonicNowNs();
+}
+
+void StartupReport::record(StartupPhase phase, int64_t beginNs, int64_t endNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isComplete()) return;
+    spans[phase].beginNs = beginNs;
+    spans[phase].endNs = endNs;
+}
+
+void StartupReport::addNote(const std::string& note) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isComplete()) return;
+    notes.push_back(note);
+}
+
+void StartupReport::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Span& span : spans) {
+        span.beginNs = 0;
+        span.endNs = 0;
+    }
+    notes.clear();
+}
+
+std::vector<int64_t> StartupReport::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<int64_t> values;
+    values.reserve(STARTUP_PHASE_COUNT * 2);
+    for (const Span& span : spans) {
+        values.push_back(span.beginNs);
+        values.push_back(span.endNs);
+    }
+    return values;
+}
+
+std::string StartupReport::report() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Offsets from the fork when Java reported it, else from the first phase
+    int64_t originNs = spans[STARTUP_PROCESS_START].beginNs;
+    if (originNs == 0) {
+        for (const Span& span : spans) {
+            if (span.beginNs != 0 && (originNs == 0 || span.beginNs < originNs)) originNs = span.beginNs;
+        }
+    }
+
+    std::string result;
+    char line[160];
+    snprintf(line, sizeof(line), "%-18s %10s %10s\n", "phase", "start ms", "took ms");
+    result += line;
+    for (int phase = 0; phase < STARTUP_PHASE_COUNT; phase++) {
+        const Span& span = spans[phase];
+        if (span.endNs == 0) {
+            snprintf(line, sizeof(line), "%-18s %10s\n", kPhaseNames[phase], "-");
+        } else {
+            snprintf(line, sizeof(line), "%-18s %10.1f %10.1f\n", kPhaseNames[phase],
+                     (span.beginNs - originNs) / 1e6, (span.endNs - span.beginNs) / 1e6);
+        }
+        result += line;
+    }
+
+    // Preload work that finished before the render thread needed it was
+    // hidden behind the splash
+    const Span& surface = spans[STARTUP_SURFACE_CREATED];
+    if (surface.endNs != 0) {
+        int64_t hiddenNs = 0;
+        for (StartupPhase phase : kPreloadPhases) {
+            const Span& span = spans[phase];
+            if (span.endNs != 0 && span.endNs <= surface.endNs) hiddenNs += span.endNs - span.beginNs;
+        }
+        snprintf(line, sizeof(line), "preload overlapped with the splash: %.1f ms\n", hiddenNs / 1e6);
+        result += line;
+    }
+    const Span& firstFrame = spans[STARTUP_FIRST_FRAME];
+    if (firstFrame.endNs != 0) {
+        snprintf(line, sizeof(line), "first frame presented %.1f ms after %s\n",
+                 (firstFrame.endNs - originNs) / 1e6,
+                 spans[STARTUP_PROCESS_START].beginNs != 0 ? "process start" : "the first phase");
+        result += line;
+    }
+    for (const std::string& note : notes) {
+        result += note;
+        result += '\n';
+    }
+    return result;
+}
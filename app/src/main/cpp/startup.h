@@ -0,0 +1,66 @@
+#ifndef TOUCHGAME_STARTUP_H
+#define TOUCHGAME_STARTUP_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Cold start timeline, from process fork to the first presented frame.
+//
+// Phases run on three threads: the UI thread (activities, surface), the
+// preload thread LoadingActivity starts while the splash is visible
+// (library, level table, renderer, round 1) and the render thread (window
+// surface, first frame). Each phase records when it began and ended in
+// CLOCK_MONOTONIC ns, the clock behind System.nanoTime() and
+// SystemClock.uptimeMillis(), so Java and native times line up. The ids
+// are mirrored in ColdStart.java.
+
+enum StartupPhase {
+    STARTUP_PROCESS_START = 0,   // zygote fork (Process.getStartUptimeMillis)
+    STARTUP_SPLASH_CREATED,      // LoadingActivity.onCreate
+    STARTUP_LIBRARY_LOAD,        // System.loadLibrary, preload thread
+    STARTUP_LEVELS_MAP,          // levels.bin mapped out of the APK
+    STARTUP_RENDERER_PRELOAD,    // context, programs, static buffers, font atlas
+    STARTUP_ROUND_PREGENERATE,   // Game and round 1 for the predicted size
+    STARTUP_GAME_ACTIVITY,       // GameActivity.onCreate
+    STARTUP_SURFACE_CREATED,     // GameView.surfaceCreated
+    STARTUP_PRELOAD_WAIT,        // render thread blocked on the preload thread
+    STARTUP_RENDERER_ATTACH,     // nativeInit: window surface (full init if not preloaded)
+    STARTUP_GAME_READY,          // preloaded round adopted or regenerated
+    STARTUP_FIRST_FRAME,         // first update + draw + present
+    STARTUP_PHASE_COUNT
+};
+
+// Filled once per process: after STARTUP_FIRST_FRAME ends, further
+// begin/end/record/addNote calls are ignored until reset()
+class StartupReport {
+public:
+    StartupReport() { reset(); }
+
+    void begin(StartupPhase phase);
+    void end(StartupPhase phase);
+    // Phases timed elsewhere (Java); beginNs == endNs for instants
+    void record(StartupPhase phase, int64_t beginNs, int64_t endNs);
+    // Free-form detail shown under the timeline (fallbacks, size mismatch)
+    void addNote(const std::string& note);
+    void reset();
+
+    // For each phase, begin and end in ns; 0 for phases not reached
+    std::vector<int64_t> snapshot() const;
+    std::string report() const;
+
+private:
+    bool isComplete() const; // first frame recorded; later calls are ignored
+
+    struct Span {
+        int64_t beginNs;
+        int64_t endNs;
+    };
+
+    mutable std::mutex mutex;
+    Span spans[STARTUP_PHASE_COUNT];
+    std::vector<std::string> notes;
+};
+
+#endif // TOUCHGAME_STARTUP_H
@@ -0,0 +1,103 @@
+#include "stream_buffer.h"
+#include "gl_state.h"
+#include <algorithm>
+#include <cstdio>
+
+static size_t grownCapacity(size_t capacity, size_t needed) {
+    while (capacity < needed && capacity < StreamBuffer::MAX_CAPACITY) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+StreamBuffer::StreamBuffer() : current(0), offset(0), targetCapacity(INITIAL_CAPACITY) {
+    for (int i = 0; i < RING_SIZE; i++) {
+        buffers[i] = 0;
+        capacities[i] = 0;
+    }
+    resetCounters();
+}
+
+void StreamBuffer::create() {
+    glGenBuffers(RING_SIZE, buffers);
+    for (int i = 0; i < RING_SIZE; i++) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, targetCapacity, nullptr, GL_STREAM_DRAW);
+        capacities[i] = targetCapacity;
+    }
+    // Start past the end so the first beginFrame() lands on buffer 0
+    current = RING_SIZE - 1;
+    offset = 0;
+}
+
+void StreamBuffer::destroy() {
+    if (buffers[0]) {
+        glDeleteBuffers(RING_SIZE, buffers);
+    }
+    for (int i = 0; i < RING_SIZE; i++) {
+        buffers[i] = 0;
+        capacities[i] = 0;
+    }
+}
+
+void StreamBuffer::orphan(GlState& state, size_t capacity) {
+    state.bindArrayBuffer(buffers[current]);
+    glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    capacities[current] = capacity;
+    offset = 0;
+}
+
+void StreamBuffer::beginFrame(GlState& state) {
+    frames++;
+    frameBytes = 0;
+
+    current = (current + 1) % RING_SIZE;
+    offset = 0;
+    // Frames that wrapped asked for more room; resize this buffer now that
+    // RING_SIZE - 1 frames have passed since it was last drawn from
+    if (capacities[current] < targetCapacity) {
+        orphan(state, targetCapacity);
+    }
+}
+
+size_t StreamBuffer::upload(GlState& state, const void* data, size_t bytes) {
+    size_t start = (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (start + bytes > capacities[current]) {
+        // Out of room: fresh storage for the rest of the frame. Draws already
+        // queued keep the old storage until the GPU has read it.
+        wraparounds++;
+        targetCapacity = grownCapacity(targetCapacity, frameBytes + bytes);
+        orphan(state, std::max(targetCapacity, bytes));
+        start = 0;
+    }
+
+    state.bindArrayBuffer(buffers[current]);
+    glBufferSubData(GL_ARRAY_BUFFER, start, bytes, data);
+    offset = start + bytes;
+
+    frameBytes += bytes;
+    if (frameBytes > peakFrameBytes) peakFrameBytes = frameBytes;
+    totalBytes += bytes;
+    uploads++;
+    return start;
+}
+
+void StreamBuffer::resetCounters() {
+    frameBytes = 0;
+    frames = 0;
+    totalBytes = 0;
+    uploads = 0;
+    peakFrameBytes = 0;
+    wraparounds = 0;
+}
+
+std::string StreamBuffer::report() const {
+    char line[192];
+    snprintf(line, sizeof(line),
+             "stream: %d x %zu KiB, %.1f KiB/frame (peak %.1f KiB), %.1f uploads/frame, "
+             "%llu wraparounds over %llu frames\n",
+             RING_SIZE, targetCapacity / 1024, frames ? totalBytes / 1024.0 / frames : 0.0,
+             peakFrameBytes / 1024.0, frames ? static_cast<double>(uploads) / frames : 0.0,
+             (unsigned long long)wraparounds, (unsigned long long)frames);
+    return line;
+}
@@ -0,0 +1,70 @@
+#ifndef TOUCHGAME_STREAM_BUFFER_H
+#define TOUCHGAME_STREAM_BUFFER_H
+
+#include <GLES2/gl2.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class GlState;
+
+// Streaming vertex data for GLES2 without implicit GPU syncs.
+//
+// Respecifying one buffer with glBufferData right after a draw sourced from
+// it makes tiled GPUs copy or stall. Instead, each frame takes the next of
+// a small ring of buffers (one per frame the GPU may still be reading) and
+// fills it front to back with glBufferSubData, so no region is overwritten
+// while a queued draw can still read it. GLES2 has no fences; the ring
+// length stands in for them.
+//
+// When a frame outgrows its buffer, the buffer is orphaned (glBufferData
+// with no data: the driver hands out fresh storage and retires the old one
+// once the GPU is done) and filling restarts at the front. Those
+// wraparounds are counted, and the ring grows so the next frames fit.
+class StreamBuffer {
+public:
+    static const int RING_SIZE = 3;
+    static const size_t INITIAL_CAPACITY = 256 * 1024;
+    // Growth stops here; larger frames keep wrapping
+    static const size_t MAX_CAPACITY = 8 * 1024 * 1024;
+    static const size_t ALIGNMENT = 16;
+
+    StreamBuffer();
+
+    // Needs a current context
+    void create();
+    void destroy();
+
+    // Moves to the next buffer of the ring; once per frame, before upload()
+    void beginFrame(GlState& state);
+    // Copies bytes into the current buffer, which stays bound, and returns
+    // their byte offset in it (a multiple of ALIGNMENT)
+    size_t upload(GlState& state, const void* data, size_t bytes);
+    GLuint getBuffer() const { return buffers[current]; }
+
+    uint64_t getFrames() const { return frames; }
+    uint64_t getBytes() const { return totalBytes; }
+    size_t getPeakFrameBytes() const { return peakFrameBytes; }
+    uint64_t getWraparounds() const { return wraparounds; }
+    void resetCounters();
+    // Bytes per frame (mean and peak), uploads, wraparounds, ring size
+    std::string report() const;
+
+private:
+    void orphan(GlState& state, size_t capacity);
+
+    GLuint buffers[RING_SIZE];
+    size_t capacities[RING_SIZE];
+    int current;
+    size_t offset;           // next free byte in the current buffer
+    size_t targetCapacity;   // what buffers are resized to when next begun
+
+    size_t frameBytes;
+    uint64_t frames;
+    uint64_t totalBytes;
+    uint64_t uploads;
+    size_t peakFrameBytes;
+    uint64_t wraparounds;
+};
+
+#endif // TOUCHGAME_STREAM_BUFFER_H
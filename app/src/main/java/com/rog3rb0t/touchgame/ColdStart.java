@@ -0,0 +1,141 @@
+package com.rog3rb0t.touchgame;
+
+import android.content.Context;
+import android.content.res.AssetManager;
+import android.os.Process;
+import android.util.Log;
+import java.util.concurrent.CountDownLatch;
+
+// Cold start pipeline. LoadingActivity calls begin() as soon as the splash
+// is up; a background thread then loads the native library, maps the level
+// table, creates the renderer's context and programs and lays out round 1
+// while the splash animates. GameView waits for it in awaitPreload() and
+// only has to attach its surface.
+//
+// Every phase is timestamped with System.nanoTime() (CLOCK_MONOTONIC, the
+// clock native code uses) into a report readable with getReport().
+final class ColdStart {
+    private static final String TAG = "ColdStart";
+
+    // Mirrors StartupPhase in startup.h
+    static final int PHASE_PROCESS_START = 0;
+    static final int PHASE_SPLASH_CREATED = 1;
+    static final int PHASE_LIBRARY_LOAD = 2;
+    static final int PHASE_GAME_ACTIVITY = 6;
+    static final int PHASE_SURFACE_CREATED = 7;
+    static final int PHASE_PRELOAD_WAIT = 8;
+    private static final int PHASE_COUNT = 12;
+
+    private static final CountDownLatch preloadDone = new CountDownLatch(1);
+    private static final Object loadLock = new Object();
+    private static boolean started = false;
+    private static volatile boolean libraryLoaded = false;
+    // Phases recorded before the library is loaded: {begin, end} per phase
+    private static final long[] pendingTimes = new long[PHASE_COUNT * 2];
+
+    private ColdStart() {
+    }
+
+    // Starts the preload thread once per process. width x height is the
+    // expected GameView size, used to lay out round 1 ahead of time.
+    static synchronized void begin(Context context, String renderer, int width, int height) {
+        if (started) return;
+        started = true;
+
+        long now = System.nanoTime();
+        long forkNanos = Process.getStartUptimeMillis() * 1000000L;
+        recordPhase(PHASE_PROCESS_START, forkNanos, forkNanos);
+        recordPhase(PHASE_SPLASH_CREATED, now, now);
+
+        final Context appContext = context.getApplicationContext();
+        final String rendererName = renderer;
+        final int expectedWidth = width;
+        final int expectedHeight = height;
+        Thread thread = new Thread(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    if (loadLibrary()) {
+                        nativePreload(appContext.getCacheDir().getAbsolutePath(), appContext.getAssets(),
+                                      rendererName, expectedWidth, expectedHeight);
+                    }
+                } catch (Throwable t) {
+                    Log.e(TAG, "Preload failed", t);
+                } finally {
+                    preloadDone.countDown();
+                }
+            }
+        }, "TouchGamePreload");
+        thread.start();
+    }
+
+    // Idempotent; GameView also calls this for launches that skip the splash.
+    // Loading holds its own lock so recording phases never waits on it.
+    static boolean loadLibrary() {
+        synchronized (loadLock) {
+            if (libraryLoaded) return true;
+            long begin = System.nanoTime();
+            try {
+                System.loadLibrary("touchgame");
+            } catch (UnsatisfiedLinkError e) {
+                Log.e(TAG, "Failed to load native library", e);
+                return false;
+            }
+            long end = System.nanoTime();
+            Log.i(TAG, "Native library loaded successfully");
+
+            synchronized (ColdStart.class) {
+                libraryLoaded = true;
+                pendingTimes[PHASE_LIBRARY_LOAD * 2] = begin;
+                pendingTimes[PHASE_LIBRARY_LOAD * 2 + 1] = end;
+                for (int phase = 0; phase < PHASE_COUNT; phase++) {
+                    if (pendingTimes[phase * 2 + 1] != 0) {
+                        nativeRecordPhase(phase, pendingTimes[phase * 2], pendingTimes[phase * 2 + 1]);
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    // Blocks until the preload thread is done; returns at once if begin()
+    // was never called (process restored straight into GameActivity)
+    static void awaitPreload() throws InterruptedException {
+        synchronized (ColdStart.class) {
+            if (!started) return;
+        }
+        long begin = System.nanoTime();
+        preloadDone.await();
+        recordPhase(PHASE_PRELOAD_WAIT, begin, System.nanoTime());
+    }
+
+    static void mark(int phase) {
+        long now = System.nanoTime();
+        recordPhase(phase, now, now);
+    }
+
+    static synchronized void recordPhase(int phase, long beginNanos, long endNanos) {
+        if (libraryLoaded) {
+            nativeRecordPhase(phase, beginNanos, endNanos);
+        } else {
+            pendingTimes[phase * 2] = beginNanos;
+            pendingTimes[phase * 2 + 1] = endNanos;
+        }
+    }
+
+    // Phase table with start offsets and durations, then a summary
+    static synchronized String getReport() {
+        return libraryLoaded ? nativeGetReport() : "";
+    }
+
+    // For each phase, begin and end in ns (0 if not reached)
+    static synchronized long[] getTimes() {
+        return libraryLoaded ? nativeGetTimes() : pendingTimes.clone();
+    }
+
+    private static native void nativePreload(String cacheDir, AssetManager assets,
+                                             String renderer, int width, int height);
+    private static native void nativeRecordPhase(int phase, long beginNanos, long endNanos);
+    private static native String nativeGetReport();
+    private static native long[] nativeGetTimes();
+}
@@ -2,7 +2,6 @@ package com.rog3rb0t.touchgame;
 
 import android.app.Activity;
 import android.os.Bundle;
-import android.widget.TextView;
 import android.widget.Toast;
 import android.widget.LinearLayout;
 import android.widget.Button;
@@ -10,7 +9,6 @@ import android.view.Gravity;
 import android.view.View;
 import android.view.WindowManager;
 import android.graphics.drawable.GradientDrawable;
-import android.graphics.Color;
 import com.google.android.gms.ads.MobileAds;
 import com.google.android.gms.ads.AdRequest;
 import com.google.android.gms.ads.AdView;
@@ -27,8 +25,6 @@ import java.util.Arrays;
 
 public class GameActivity extends Activity {
     private GameView gameView;
-    private TextView scoreText;
-    private TextView roundText;
     private LinearLayout layout;
     private InterstitialAd interstitialAd;
     private AdView bannerAdView;
@@ -37,6 +33,7 @@ public class GameActivity extends Activity {
     @Override
     protected void onCreate(Bundle savedInstanceState) {
         super.onCreate(savedInstanceState);
+        ColdStart.mark(ColdStart.PHASE_GAME_ACTIVITY);
 
         // Keep screen on during gameplay
         getWindow().addFlags(WindowManager.LayoutParams.FLAG_KEEP_SCREEN_ON);
@@ -45,27 +42,10 @@ public class GameActivity extends Activity {
         layout = new LinearLayout(this);
         layout.setOrientation(LinearLayout.VERTICAL);
         
-        // Score and round display
-        LinearLayout infoLayout = new LinearLayout(this);
-        infoLayout.setOrientation(LinearLayout.HORIZONTAL);
-        infoLayout.setGravity(Gravity.CENTER);
-        infoLayout.setPadding(20, 20, 20, 20);
-        
-        scoreText = new TextView(this);
-        scoreText.setText("Score: 0");
-        scoreText.setTextSize(20);
-        scoreText.setPadding(20, 0, 20, 0);
-        
-        roundText = new TextView(this);
-        roundText.setText("Round: 1");
-        roundText.setTextSize(20);
-        roundText.setPadding(20, 0, 20, 0);
-        
-        infoLayout.addView(scoreText);
-        infoLayout.addView(roundText);
-        
-        // Game view
+        // Game view (score and round are drawn by the native HUD)
         gameView = new GameView(this, this);
+        // adb shell am start -n com.rog3rb0t.touchgame/.LoadingActivity --es renderer gles2
+        gameView.setRenderer(getIntent().getStringExtra("renderer"));
         LinearLayout.LayoutParams gameParams = new LinearLayout.LayoutParams(
             LinearLayout.LayoutParams.MATCH_PARENT,
             0,
@@ -84,7 +64,6 @@ public class GameActivity extends Activity {
         );
         bannerAdView.setLayoutParams(adParams);
         
-        layout.addView(infoLayout);
         layout.addView(gameView);
         layout.addView(bannerAdView);
         
@@ -96,13 +75,6 @@ public class GameActivity extends Activity {
             loadBannerAd();
         });
         
-        // Set initial gradient after a short delay to ensure native side is ready
-        gameView.postDelayed(new Runnable() {
-            @Override
-            public void run() {
-                updateGradient();
-            }
-        }, 200);
         
         // Show game instructions for 10 seconds
         final Toast toast = Toast.makeText(this, 
@@ -142,40 +114,20 @@ public class GameActivity extends Activity {
                 colors
             );
             layout.setBackground(gradient);
-            
-            // Calculate average luminance of both gradient colors
-            float lum1 = (0.299f * Color.red(colors[0]) + 
-                         0.587f * Color.green(colors[0]) + 
-                         0.114f * Color.blue(colors[0])) / 255.0f;
-            float lum2 = (0.299f * Color.red(colors[1]) + 
-                         0.587f * Color.green(colors[1]) + 
-                         0.114f * Color.blue(colors[1])) / 255.0f;
-            float avgLuminance = (lum1 + lum2) / 2.0f;
-            
-            // Set text color based on background brightness
-            int textColor = avgLuminance > 0.5f ? Color.BLACK : Color.WHITE;
-            scoreText.setTextColor(textColor);
-            roundText.setTextColor(textColor);
-            
-            // Add shadow for better readability
-            if (avgLuminance > 0.5f) {
-                scoreText.setShadowLayer(2, 1, 1, Color.WHITE);
-                roundText.setShadowLayer(2, 1, 1, Color.WHITE);
-            } else {
-                scoreText.setShadowLayer(2, 1, 1, Color.BLACK);
-                roundText.setShadowLayer(2, 1, 1, Color.BLACK);
-            }
         } catch (Exception e) {
             // Fallback to white if native side not ready
             layout.setBackgroundColor(0xFFFFFFFF);
-            scoreText.setTextColor(Color.BLACK);
-            roundText.setTextColor(Color.BLACK);
         }
     }
 
-    public void updateScore(int score, int round) {
-        scoreText.setText("Score: " + score);
-        roundText.setText("Round: " + round);
+    // Called by GameView once the native game exists and round 1 is set up
+    public void onGameReady() {
+        updateGradient();
+    }
+
+    // Called by GameView only when the round changes; the per-frame score
+    // display is handled by the native HUD
+    public void onRoundChanged(int round) {
         updateGradient();
         
         // Show interstitial ad every 5 levels
@@ -1,6 +1,8 @@
 package com.rog3rb0t.touchgame;
 
 import android.content.Context;
+import android.content.res.AssetManager;
+import android.os.Build;
 import android.view.Surface;
 import android.view.SurfaceHolder;
 import android.view.SurfaceView;
@@ -16,14 +18,12 @@ public class GameView extends SurfaceView implements SurfaceHolder.Callback, Run
     private volatile boolean running = false;
     private SurfaceHolder holder;
     private GameActivity activity;
+    // Render backend name ("gles2"); null lets native code pick
+    private String renderer;
 
     static {
-        try {
-            System.loadLibrary("touchgame");
-            Log.i(TAG, "Native library loaded successfully");
-        } catch (UnsatisfiedLinkError e) {
-            Log.e(TAG, "Failed to load native library", e);
-        }
+        // Normally already loaded by the splash's preload thread
+        ColdStart.loadLibrary();
     }
 
     public GameView(Context context, GameActivity activity) {
@@ -33,9 +33,21 @@ public class GameView extends SurfaceView implements SurfaceHolder.Callback, Run
         holder.addCallback(this);
     }
 
+    // Takes effect the next time the surface is created
+    public void setRenderer(String renderer) {
+        this.renderer = renderer;
+    }
+    
+    // Backend actually in use; differs from the requested one if it failed
+    // to initialize and native code fell back to GLES2
+    public String getRendererName() {
+        return nativeGetRendererName();
+    }
+
     @Override
     public void surfaceCreated(SurfaceHolder holder) {
         Log.i(TAG, "Surface created");
+        ColdStart.mark(ColdStart.PHASE_SURFACE_CREATED);
         running = true;
         renderThread = new Thread(this);
         renderThread.start();
@@ -60,34 +72,64 @@ public class GameView extends SurfaceView implements SurfaceHolder.Callback, Run
 
     @Override
     public void run() {
-        // Initialize OpenGL on the render thread
+        // Attach the surface to the renderer the preload thread prepared
+        // during the splash (or initialize everything here without one)
         try {
+            ColdStart.awaitPreload();
             Log.i(TAG, "Calling nativeInit");
-            nativeInit(holder.getSurface());
+            if (!nativeInit(holder.getSurface(), getContext().getCacheDir().getAbsolutePath(), renderer,
+                            getContext().getAssets())) {
+                Log.e(TAG, "No renderer could be initialized");
+                return;
+            }
             Log.i(TAG, "nativeInit completed");
-            Thread.sleep(100);
         } catch (Exception e) {
             Log.e(TAG, "Error in nativeInit", e);
             e.printStackTrace();
             return;
         }
         
+        // The game is ready: let the activity read its state
+        activity.runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                activity.onGameReady();
+            }
+        });
+        
+        boolean firstFrame = true;
+        int lastRound = 0;
         while (running) {
             try {
                 nativeRender();
                 
-                // Update UI on main thread
-                activity.runOnUiThread(new Runnable() {
-                    @Override
-                    public void run() {
-                        activity.updateScore(nativeGetScore(), nativeGetRound());
-                        
-                        if (nativeIsGameOver()) {
+                if (firstFrame) {
+                    firstFrame = false;
+                    Log.i(TAG, "Cold start:\n" + ColdStart.getReport());
+                }
+                
+                // Score and round are drawn natively; only round changes and
+                // game over need the UI thread
+                final int round = nativeGetRound();
+                if (round != lastRound) {
+                    lastRound = round;
+                    activity.runOnUiThread(new Runnable() {
+                        @Override
+                        public void run() {
+                            activity.onRoundChanged(round);
+                        }
+                    });
+                }
+                
+                if (nativeIsGameOver()) {
+                    activity.runOnUiThread(new Runnable() {
+                        @Override
+                        public void run() {
                             activity.showGameOver();
-                            running = false;
                         }
-                    }
-                });
+                    });
+                    running = false;
+                }
                 
                 Thread.sleep(16); // ~60 FPS
             } catch (Exception e) {
@@ -99,26 +141,59 @@ public class GameView extends SurfaceView implements SurfaceHolder.Callback, Run
     @Override
     public boolean onTouchEvent(MotionEvent event) {
         if (event.getAction() == MotionEvent.ACTION_DOWN) {
-            Log.i(TAG, "Touch event: " + event.getX() + ", " + event.getY());
-            
             // Provide immediate haptic feedback for all touches
             performHapticFeedback(HapticFeedbackConstants.VIRTUAL_KEY);
             
-            boolean result = nativeTouch(event.getX(), event.getY());
-            Log.i(TAG, "Touch result: " + result);
+            boolean result = nativeTouch(event.getX(), event.getY(), eventTimeNanos(event));
             
             // Stronger haptic feedback for successful hits
             if (result) {
                 performHapticFeedback(HapticFeedbackConstants.LONG_PRESS);
             }
+        } else if (BuildConfig.DEBUG && event.getActionMasked() == MotionEvent.ACTION_POINTER_DOWN
+                && event.getPointerCount() == 3) {
+            // Hidden debug toggle: a three-finger tap hands the game to the
+            // native autoplayer (or takes it back)
+            showToast(nativeToggleAutoplay() ? "Autoplay on" : "Autoplay off");
         }
         return true;
     }
 
+    // Input timestamps share CLOCK_MONOTONIC with the native side; only API 34+
+    // exposes them at full resolution
+    private static long eventTimeNanos(MotionEvent event) {
+        if (Build.VERSION.SDK_INT >= 34) {
+            return event.getEventTimeNanos();
+        }
+        return event.getEventTime() * 1000000L;
+    }
+
     public void resetGame() {
         nativeReset();
     }
     
+    // Formats the native event log; touch and round events are only
+    // recorded in binary form until someone asks for them
+    public String dumpEventLog() {
+        return nativeDumpEventLog();
+    }
+    
+    // Touch-to-photon latency histograms. For each stage (input->sim,
+    // sim->submit, submit->present, input->present) the array holds count,
+    // sum, min and max in ns followed by one count per 1 ms bucket.
+    public long[] getLatencyStats() {
+        return nativeGetLatencyStats();
+    }
+    
+    public String getLatencyReport() {
+        return nativeGetLatencyReport();
+    }
+    
+    // Timeline from process start to the first frame, see ColdStart
+    public String getStartupReport() {
+        return ColdStart.getReport();
+    }
+    
     // Called from native code to show toast messages
     public void showToast(final String message) {
         activity.runOnUiThread(new Runnable() {
@@ -132,14 +207,19 @@ public class GameView extends SurfaceView implements SurfaceHolder.Callback, Run
     }
 
     // Native methods
-    private native void nativeInit(Surface surface);
+    private native boolean nativeInit(Surface surface, String cacheDir, String renderer, AssetManager assets);
     private native void nativeRender();
-    private native boolean nativeTouch(float x, float y);
+    private native boolean nativeTouch(float x, float y, long eventTimeNanos);
+    private native boolean nativeToggleAutoplay();
     private native int nativeGetScore();
     private native int nativeGetRound();
     private native boolean nativeIsGameOver();
     private native void nativeDestroy();
     private native void nativeReset();
+    private native String nativeDumpEventLog();
+    private native long[] nativeGetLatencyStats();
+    private native String nativeGetLatencyReport();
+    private native String nativeGetRendererName();
     private native float nativeGetBgColorR1();
     private native float nativeGetBgColorG1();
     private native float nativeGetBgColorB1();
@@ -4,9 +4,11 @@ import android.app.Activity;
 import android.content.Intent;
 import android.os.Bundle;
 import android.os.Handler;
+import android.util.DisplayMetrics;
 import android.view.animation.Animation;
 import android.view.animation.TranslateAnimation;
 import android.widget.ImageView;
+import com.google.android.gms.ads.AdSize;
 
 public class LoadingActivity extends Activity {
     private static final int LOADING_DURATION = 2500; // 2.5 seconds
@@ -16,6 +18,12 @@ public class LoadingActivity extends Activity {
         super.onCreate(savedInstanceState);
         setContentView(R.layout.activity_loading);
 
+        // Prepare the game while the splash is on screen. GameView fills the
+        // fullscreen window above the banner ad.
+        DisplayMetrics metrics = getResources().getDisplayMetrics();
+        ColdStart.begin(this, getIntent().getStringExtra("renderer"), metrics.widthPixels,
+                        metrics.heightPixels - AdSize.BANNER.getHeightInPixels(this));
+
         ImageView loadingImage = findViewById(R.id.loadingImage);
         
         // Animate the ball moving out of the phone
@@ -33,6 +41,8 @@ public class LoadingActivity extends Activity {
             @Override
             public void run() {
                 Intent intent = new Intent(LoadingActivity.this, GameActivity.class);
+                // Pass through a renderer override from the launching intent
+                intent.putExtra("renderer", getIntent().getStringExtra("renderer"));
                 startActivity(intent);
                 finish();
             }